@@ -12,6 +12,40 @@
 // ===== Included Headers =====
 #include <pebble.h>
 #include <time.h>
+#include "feature_profile.h"
+#include "calendar.h"
+
+
+// ===== Feature Profile =====
+#define FEATURE_WEEKDAY_NAMES (FEATURE_WEEKDAY_EN || FEATURE_WEEKDAY_FR || FEATURE_WEEKDAY_ES)
+#define FEATURE_WEEKDAY_DIGITS (FEATURE_WEEKDAY_INTL || FEATURE_MONTH_GRID)
+
+// Step progress needs Pebble Health, which only some platforms have
+#if FEATURE_STEPS && !defined(PBL_HEALTH)
+#undef FEATURE_STEPS
+#define FEATURE_STEPS 0
+#endif
+
+// The second time zone needs time() to return UTC, which only SDK 3 does (SDK 2 returns the local time)
+#if FEATURE_SECOND_TZ && !defined(PBL_SDK_3)
+#undef FEATURE_SECOND_TZ
+#define FEATURE_SECOND_TZ 0
+#endif
+
+#if !FEATURE_WEEKDAY_INTL && !FEATURE_WEEKDAY_NAMES
+#error "The feature profile must include at least one weekday format"
+#endif
+
+// Weekday format used when the settings ask for one that isn't part of the build
+#if FEATURE_WEEKDAY_INTL
+#define WEEKDAY_FORMAT_DEFAULT INTL
+#elif FEATURE_WEEKDAY_EN
+#define WEEKDAY_FORMAT_DEFAULT EN
+#elif FEATURE_WEEKDAY_FR
+#define WEEKDAY_FORMAT_DEFAULT FR
+#else
+#define WEEKDAY_FORMAT_DEFAULT ES
+#endif
 
 
 // ===== Function Declarations =====
@@ -37,7 +71,10 @@ enum settings_app_message_keys {
     Leading_Zero = 4,
     Weekday_First_Day = 5,
     Date_Format = 6,
-    Display_Battery = 7
+    Display_Battery = 7,
+    Display_Steps = 8,
+    Step_Goal = 9,
+    Second_TZ_Table = 10
 };
 
 enum settings_storage_keys {
@@ -47,9 +84,31 @@ enum settings_storage_keys {
     Key_Leading_Zero = 4,
     Key_Weekday_First_Day = 5,
     Key_Date_Format = 6,
-    Key_Display_Battery = 7
+    Key_Display_Battery = 7,
+    Key_Display_Steps = 8,
+    Key_Step_Goal = 9,
+    Key_Second_TZ_Table = 10
 };
 
+typedef struct Weekday_Glyph {
+    int16_t x, width, height;
+} Weekday_Glyph;
+
+typedef struct Weekday_Letter {
+    uint16_t codepoint;
+    uint8_t glyph;
+    int8_t x, y;
+} Weekday_Letter;
+
+typedef struct Weekday_Language {
+    int16_t pitch;
+    const Weekday_Letter *letters;
+    int16_t letters_nb;
+    const char *names[7];
+    int16_t baselines[7];
+    uint16_t shifts[7];
+} Weekday_Language;
+
 typedef struct Settings_Type {
     int16_t weekday_format;
     bool vibrate_on_hour;
@@ -58,45 +117,79 @@ typedef struct Settings_Type {
     int16_t weekday_first_day;
     char date_format[10];
     bool display_battery;
+    bool display_steps;
+    int32_t step_goal;
 } Settings_Type;
 
+// Glyph atlas and per-language tables for the weekday names
+#include "weekday_letters.h"
+
 static const Rect_Predef Screen_Dim = {0, 0, 144, 168};
 static const Rect_Predef Weekday_BG_Layer_Dim = {0, 0, 15, 168};
 static const Rect_Predef Weekday_Layer_Dim = {0, 0, 14, 168};
 static const Rect_Predef Date_BG_Layer_Dim = {133, 0, 11, 168};
 static const Rect_Predef Date_Layer_Dim = {2, 0, 9, 168};
+#if FEATURE_AMPM
 static const Rect_Predef AmPm_Layer_Dim = {71, 80, 7, 12};
+#endif
 static const Rect_Predef Hours_Layer_Dim = {15, 0, 118, 80};
 static const Rect_Predef Minutes_Layer_Dim = {15, 88, 118, 80};
 static const Rect_Predef Seconds_BG_Layer_Dim = {15, 81, 118, 10};
+#if FEATURE_SECONDS
 static const Rect_Predef Seconds_Layer_Dim = {0, 4, 118, 2};
+#endif
+#if FEATURE_MONTH_GRID
+static const Rect_Predef Month_Layer_Dim = {15, 0, 118, 168};
+#endif
 static const Rect_Predef Time_Digit[2] = {{0, 0, 60, 82}, {60, 0, 60, 82}};
 static const Rect_Predef Date_Digit = {0, 0, 10, 13};
 
 static const int16_t Offset = 1;
 
+#if FEATURE_AMPM
 static const int16_t Am_Base_Y = 3,
                      Pm_Base_Y = 8,
                      AmPm_Width = 6,
                      AmPm_Height = 4;
+#endif
 
 static const int16_t Seconds_BG_Y1 = 3,
                      Seconds_BG_Y2 = 6,
-                     Seconds_Width = 2,
-                     Seconds_Height = 2,
                      Seconds_BG_Ind30_X = 59,
                      Seconds_BG_Ind15_X = 29,
                      Seconds_BG_Ind45_X = 89;
 
+#if FEATURE_SECONDS
+static const int16_t Seconds_Width = 2,
+                     Seconds_Height = 2;
+#endif
+
 static const int16_t Date_Max_Char = 10,
                      Date_Char_Height = 16,
                      Date_Char_Space = 5;
 
-static const int16_t Weekday_Day_Height = 24,
-                     Weekday_Nb = 7,
-                     Weekday_Max_Delta = 3;
+#if FEATURE_WEEKDAY_INTL
+static const int16_t Weekday_Day_Height = 24;
+#endif
+
+#if FEATURE_MONTH_GRID
+static const int16_t Month_Cell_Width = 16,
+                     Month_Cell_Height = 24;
+#endif
+
+static const int16_t Steps_Default_Goal = 10000;
+// Goals are accepted from 1 to this, the configuration page uses the same range
+static const int32_t Steps_Max_Goal = 100000;
+
+// Second time zone transitions sent by the phone: UTC time (4 bytes) and UTC offset in minutes (2 bytes), little-endian
+#define SECOND_TZ_TRANSITION_SIZE 6
+#define SECOND_TZ_TRANSITIONS_MAX 32
+
+#if FEATURE_MONTH_GRID
+// How long the month grid stays over the time after a tap
+static const uint32_t Month_Display_Ms = 5000;
+#endif
 
-static int16_t mday_max[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
 
 
 // ===== Global Variables =====
@@ -106,27 +199,58 @@ static Layer * window_layer,
              * weekday_layer,
              * date_bg_layer,
              * date_layer,
-             * ampm_layer,
              * hours_layer,
              * minutes_layer,
-             * seconds_bg_layer,
-             * seconds_layer;
-GBitmap * weekday_digits[10],
-        * weekday_names[7],
-        * date_digits[10],
+             * seconds_bg_layer;
+#if FEATURE_AMPM
+static Layer * ampm_layer;
+#endif
+#if FEATURE_SECONDS
+static Layer * seconds_layer;
+#endif
+#if FEATURE_MONTH_GRID
+static Layer * month_layer;
+#endif
+#if FEATURE_WEEKDAY_DIGITS
+GBitmap * weekday_digits[10];
+bool weekday_digits_loaded = false;
+struct Calendar_Type calendar;
+#endif
+#if FEATURE_MONTH_GRID
+AppTimer * month_timer;
+#endif
+#if FEATURE_SECOND_TZ
+uint32_t second_tz_times[SECOND_TZ_TRANSITIONS_MAX];
+int16_t second_tz_offsets[SECOND_TZ_TRANSITIONS_MAX],
+        second_tz_nb = 0,
+        second_tz_hour = -1,
+        second_tz_minute = -1;
+#endif
+#if FEATURE_WEEKDAY_NAMES
+GBitmap * weekday_letters,
+        * weekday_glyphs[WEEKDAY_GLYPHS_NB];
+#endif
+GBitmap * date_digits[10],
         * time_digits[10];
 struct tm current_time;
 int16_t battery_state;
+#if FEATURE_STEPS
+int16_t steps_width = 0;
+uint32_t steps_events = 0,
+         steps_reads = 0,
+         steps_redraws = 0;
+#endif
 struct Settings_Type settings;
 bool settings_initialized = false;
 
 
 // Utility method to convert a simple string to an integer
-static int16_t string_to_int(char* string) {
-    int16_t maxlen = strlen(string),
-        result = 0;
-    if (maxlen > 10) {
-        maxlen = 10;
+static int32_t string_to_int(char* string) {
+    int16_t maxlen = strlen(string);
+    int32_t result = 0;
+    // 9 digits always fit in 32 bits
+    if (maxlen > 9) {
+        maxlen = 9;
     }
     for (int16_t i=0; i<maxlen; i++) {
         if (string[i] >= '0' && string[i] <= '9') {
@@ -137,17 +261,170 @@ static int16_t string_to_int(char* string) {
 }
 
 
+// Utility method to get the hour as it is displayed (12-hour or 24-hour clock)
+static int16_t display_hour(int16_t hour) {
+    if (!clock_is_24h_style()) {
+        if (hour > 12) {
+            hour = hour - 12;
+        }
+        if (hour == 0) {
+            hour = 12;
+        }
+    }
+    return hour;
+}
+
+
+// Utility method to fall back to the default weekday format if the requested one isn't part of the build
+static int16_t supported_weekday_format(int16_t format) {
+    switch (format) {
+#if FEATURE_WEEKDAY_INTL
+        case INTL:
+#endif
+#if FEATURE_WEEKDAY_EN
+        case EN:
+#endif
+#if FEATURE_WEEKDAY_FR
+        case FR:
+#endif
+#if FEATURE_WEEKDAY_ES
+        case ES:
+#endif
+            return format;
+    }
+    return WEEKDAY_FORMAT_DEFAULT;
+}
+
+
+#if FEATURE_WEEKDAY_DIGITS
+// Load the digits used by the weekday column and the month grid
+static void weekday_digits_load(void) {
+    if (weekday_digits_loaded) {
+        return;
+    }
+    weekday_digits[0] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_0);
+    weekday_digits[1] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_1);
+    weekday_digits[2] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_2);
+    weekday_digits[3] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_3);
+    weekday_digits[4] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_4);
+    weekday_digits[5] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_5);
+    weekday_digits[6] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_6);
+    weekday_digits[7] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_7);
+    weekday_digits[8] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_8);
+    weekday_digits[9] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_9);
+    weekday_digits_loaded = true;
+}
+
+
+// Unload the digits used by the weekday column and the month grid
+static void weekday_digits_unload(void) {
+    if (!weekday_digits_loaded) {
+        return;
+    }
+    for (int16_t i = 0; i < 10; i++) {
+        gbitmap_destroy(weekday_digits[i]);
+    }
+    weekday_digits_loaded = false;
+}
+
+
+// Drawing a day of the month in a cell of the weekday column or the month grid
+static void weekday_digits_draw(GContext *ctx, int16_t mday, GRect cell, bool today) {
+    int16_t base_x = cell.origin.x + ((cell.size.w - 14) / 2),
+            base_y = cell.origin.y + (cell.size.h / 2) - 5;
+    if (today) {
+        // If we're drawing today's date, we need to fill in the background in white...
+        graphics_context_set_fill_color(ctx, GColorWhite);
+        graphics_fill_rect(ctx, cell, 0, GCornerNone);
+        // ... and draw our digits in inverted mode
+        graphics_context_set_compositing_mode(ctx, GCompOpAssignInverted);
+    }
+    if (mday >= 10) {
+        graphics_draw_bitmap_in_rect(ctx, weekday_digits[mday / 10], GRect(base_x, base_y, 6, 11));
+    }
+    graphics_draw_bitmap_in_rect(ctx, weekday_digits[mday % 10], GRect(base_x + 7, base_y, 6, 11));
+    if (today) {
+        // Switching the context back to normal mode
+        graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+    }
+}
+#endif
+
+
+#if FEATURE_WEEKDAY_NAMES
+// Utility method to get the weekday names of a language
+static const Weekday_Language * weekday_language(int16_t format) {
+    switch (format) {
+#if FEATURE_WEEKDAY_EN
+        case EN:
+            return &Weekday_Language_EN;
+#endif
+#if FEATURE_WEEKDAY_FR
+        case FR:
+            return &Weekday_Language_FR;
+#endif
+#if FEATURE_WEEKDAY_ES
+        case ES:
+            return &Weekday_Language_ES;
+#endif
+    }
+    return NULL;
+}
+
+
+// Utility method to read the next character of an UTF-8 string
+static uint16_t utf8_next(const char **string) {
+    const uint8_t *bytes = (const uint8_t *)*string;
+    if (bytes[0] < 0x80) {
+        *string += 1;
+        return bytes[0];
+    }
+    if ((bytes[0] & 0xe0) == 0xc0 && bytes[1] != '\0') {
+        *string += 2;
+        return ((bytes[0] & 0x1f) << 6) | (bytes[1] & 0x3f);
+    }
+    if ((bytes[0] & 0xf0) == 0xe0 && bytes[1] != '\0' && bytes[2] != '\0') {
+        *string += 3;
+        return ((bytes[0] & 0x0f) << 12) | ((bytes[1] & 0x3f) << 6) | (bytes[2] & 0x3f);
+    }
+    // Invalid or unsupported sequence, skip it
+    *string += 1;
+    return '?';
+}
+
+
+// Load the letters shared by all the weekday languages
+static void weekday_letters_load(void) {
+    weekday_letters = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_LETTERS);
+    for (int16_t i = 0; i < WEEKDAY_GLYPHS_NB; i++) {
+        weekday_glyphs[i] = gbitmap_create_as_sub_bitmap(weekday_letters, GRect(Weekday_Glyphs[i].x, 0, Weekday_Glyphs[i].width, Weekday_Glyphs[i].height));
+    }
+}
+
+
+// Unload the letters shared by all the weekday languages
+static void weekday_letters_unload(void) {
+    for (int16_t i = 0; i < WEEKDAY_GLYPHS_NB; i++) {
+        gbitmap_destroy(weekday_glyphs[i]);
+    }
+    gbitmap_destroy(weekday_letters);
+}
+#endif
+
+
 // Drawing the weekday background layer
 static void weekday_bg_layer_draw(Layer *layer, GContext *ctx) {
     GRect bounds = layer_get_bounds(layer);
     graphics_context_set_stroke_color(ctx, GColorWhite);
     graphics_draw_line(ctx, GPoint(bounds.size.w - Offset, 0), GPoint(bounds.size.w - Offset, bounds.size.h - Offset));
 
+#if FEATURE_WEEKDAY_INTL
     if (settings.weekday_format == INTL) {
         for (int16_t i = 1; i < Weekday_Nb; i++) {
             graphics_draw_line(ctx, GPoint(0, i * Weekday_Day_Height), GPoint(bounds.size.w, i * Weekday_Day_Height));
         }
     }
+#endif
 }
 
 
@@ -167,14 +444,21 @@ static void seconds_bg_layer_draw(Layer *layer, GContext *ctx) {
     int16_t seconds_bg_y_offset = settings.display_seconds ? 0 : 1;
 
     int16_t indicator_width = bounds.size.w;
-    if (settings.display_battery) {
+#if FEATURE_BATTERY
+    if (settings.display_battery && !settings.display_steps) {
         indicator_width = indicator_width * battery_state / 100;
     }
+#endif
+#if FEATURE_STEPS
+    if (settings.display_steps) {
+        indicator_width = steps_width;
+    }
+#endif
     
     graphics_draw_line(ctx, GPoint(0, Seconds_BG_Y1 + seconds_bg_y_offset), GPoint(indicator_width, Seconds_BG_Y1 + seconds_bg_y_offset));
     graphics_draw_line(ctx, GPoint(0, Seconds_BG_Y2 - seconds_bg_y_offset), GPoint(indicator_width, Seconds_BG_Y2 - seconds_bg_y_offset));
 
-    if (settings.display_seconds || settings.display_battery) {
+    if (settings.display_seconds || settings.display_battery || settings.display_steps) {
         // Halfway indicator (30s / 50%)
         graphics_draw_line(ctx, GPoint(Seconds_BG_Ind30_X, 0), GPoint(Seconds_BG_Ind30_X, Offset));
         graphics_draw_line(ctx, GPoint(Seconds_BG_Ind30_X, Seconds_BG_Y2 + (Offset * 2)), GPoint(Seconds_BG_Ind30_X, Seconds_BG_Y2 + (Offset * 2) + Offset));
@@ -190,29 +474,38 @@ static void seconds_bg_layer_draw(Layer *layer, GContext *ctx) {
 }
 
 
+#if FEATURE_WEEKDAY_NAMES
+// Drawing a weekday name, one letter under the other
+static void weekday_name_draw(GContext *ctx, const Weekday_Language *language, int16_t wday) {
+    const char *name = language->names[wday];
+    int16_t baseline = language->baselines[wday];
+    for (int16_t i = 0; *name != '\0'; i++) {
+        uint16_t codepoint = utf8_next(&name);
+        for (int16_t j = 0; j < language->letters_nb; j++) {
+            const Weekday_Letter *letter = &language->letters[j];
+            if (letter->codepoint == codepoint) {
+                const Weekday_Glyph *glyph = &Weekday_Glyphs[letter->glyph];
+                // Some occurrences of a letter sit one pixel to the right of its usual position
+                int16_t x = letter->x + ((language->shifts[wday] >> i) & 1);
+                graphics_draw_bitmap_in_rect(ctx, weekday_glyphs[letter->glyph], GRect(x, baseline + letter->y, glyph->width, glyph->height));
+                break;
+            }
+        }
+        baseline += language->pitch;
+    }
+}
+#endif
+
+
 // Drawing the weekday layer
 static void weekday_layer_draw(Layer *layer, GContext *ctx) {
     graphics_context_set_stroke_color(ctx, GColorWhite);
 
+#if FEATURE_WEEKDAY_INTL
     if (settings.weekday_format == INTL) {
         for (int16_t position = 0; position < Weekday_Nb; position++) {
-            // Day of the month being drawn, based on the current day
-            int16_t mday = current_time.tm_mday;
-            // Day of the week being drawn, based on the current weekday
-            int16_t wday = current_time.tm_wday;
-            // Handle displaying a day other than Sunday as the first day
-            wday = (wday + (Weekday_Nb - settings.weekday_first_day)) % Weekday_Nb;
             // Difference between the position we're drawing and the current weekday
-            int16_t mday_delta = position - wday;
-
-            if (mday_delta < -Weekday_Max_Delta) {
-                // If the day delta is too low, we actually draw a day in the future instead  (Sunday to Tuesday when currently Thursday or later in the week)
-                mday_delta += Weekday_Nb;
-            }
-            else if (mday_delta > Weekday_Max_Delta) {
-                // If the day delta is too high, we actually draw a day in the past instead (Thursday to Saturday when currently Tuesday or earlier in the week)
-                mday_delta -= Weekday_Nb;
-            }
+            int16_t mday_delta = calendar.week_deltas[position];
 
             // To separate the weekdays in the past from those in the future, we draw an arrow on the border (except if that border is spread out on the screen edges)
             int16_t line;
@@ -238,55 +531,16 @@ static void weekday_layer_draw(Layer *layer, GContext *ctx) {
                     break;
             }
 
-            // Decide what the day of the month we're drawing actually is
-            mday += mday_delta;
-            if (mday < 1) {
-                // If we're in the past and accross a month's start, get the last day of the previous month and count from there
-                int16_t new_month = current_time.tm_mon - 1;
-                // watch out for December...
-                if (new_month == -1) {
-                    new_month = 11;
-                }
-                mday += mday_max[new_month];
-                // ... and February on leap years (not checking for the 100s and 400s rules since they won't occur for 87 years...)
-                if ((new_month == 1) && ((current_time.tm_year + 1900) % 4 == 0)) {
-                    mday++;
-                }
-            }
-            else if (mday > mday_max[current_time.tm_mon]) {
-                // If we're in the future and past the current month's end, start from 1 in the next month
-                int mday_mod = mday_max[current_time.tm_mon];
-                // watch out for February in leap years here too
-                if ((current_time.tm_mon == 1) && ((current_time.tm_year + 1900) % 4 == 0)) {
-                    mday_mod++;
-                }
-                mday %= mday_mod;
-            }
-
-            // Decide where to draw and in what color
-            int base_y = (position * Weekday_Day_Height) + 12 - 5;
-            int color = (bool)(wday == position);
-            if (color) {
-                // If we're drawing today's date, we need to fill in the background in white...
-                graphics_context_set_fill_color(ctx, GColorWhite);
-                graphics_fill_rect(ctx, GRect(0, position * Weekday_Day_Height, 14, Weekday_Day_Height), 0, GCornerNone);
-                // ... and draw our digits in inverted mode
-                graphics_context_set_compositing_mode(ctx, GCompOpAssignInverted);
-            }
-            // draw the actual digits from what we decided above
-            if (mday >= 10) {
-                graphics_draw_bitmap_in_rect(ctx, weekday_digits[mday / 10], GRect(0, base_y, 6, 11));
-            }
-            graphics_draw_bitmap_in_rect(ctx, weekday_digits[mday % 10], GRect(7, base_y, 6, 11));
-            if (color) {
-                // Switching the context back to normal mode
-                graphics_context_set_compositing_mode(ctx, GCompOpAssign);
-            }
+            // Draw the day of the month, today's in reverse color
+            weekday_digits_draw(ctx, calendar.week_mdays[position], GRect(0, position * Weekday_Day_Height, 14, Weekday_Day_Height), mday_delta == 0);
         }
     }
-    else {
-        graphics_draw_bitmap_in_rect(ctx, weekday_names[current_time.tm_wday], GRect(Weekday_Layer_Dim.x, Weekday_Layer_Dim.y, Weekday_Layer_Dim.width, Weekday_Layer_Dim.height));
+#endif
+#if FEATURE_WEEKDAY_NAMES
+    if (settings.weekday_format != INTL) {
+        weekday_name_draw(ctx, weekday_language(settings.weekday_format), current_time.tm_wday);
     }
+#endif
 }
 
 
@@ -374,6 +628,34 @@ static void date_layer_draw(Layer *layer, GContext *ctx) {
                 }
                 j++;
                 break;
+#if FEATURE_SECOND_TZ
+            // Second time zone, left blank until the phone sent its offsets
+            case 'H':
+            case 'h':
+                if (second_tz_hour >= 0) {
+                    int16_t hour = second_tz_hour;
+                    if (current_date_format[i] == 'h') {
+                        hour = hour % 12 == 0 ? 12 : hour % 12;
+                    }
+                    date_int[j] = hour / 10;
+                    date_int[++j] = hour % 10;
+                }
+                else {
+                    j++;
+                }
+                j++;
+                break;
+            case 'N':
+                if (second_tz_minute >= 0) {
+                    date_int[j] = second_tz_minute / 10;
+                    date_int[++j] = second_tz_minute % 10;
+                }
+                else {
+                    j++;
+                }
+                j++;
+                break;
+#endif
             // Any other character has no meaning so we ignore it
         }
     }
@@ -405,6 +687,7 @@ static void date_layer_draw(Layer *layer, GContext *ctx) {
 }
 
 
+#if FEATURE_AMPM
 // Drawing the ampm layer
 static void ampm_layer_draw(Layer *layer, GContext *ctx) {
     if (!clock_is_24h_style()) {
@@ -416,20 +699,12 @@ static void ampm_layer_draw(Layer *layer, GContext *ctx) {
         }
     }
 }
+#endif
 
 
 // Drawing the hours layer
 static void hours_layer_draw(Layer *layer, GContext *ctx) {
-    int16_t hour = current_time.tm_hour;
-    // Deal with the 12-hour clock
-    if (!clock_is_24h_style()) {
-        if (hour > 12) {
-            hour = hour - 12;
-        }
-        if (hour == 0) {
-            hour = 12;
-        }
-    }
+    int16_t hour = display_hour(current_time.tm_hour);
     if (settings.leading_zero || hour >= 10) {
         graphics_draw_bitmap_in_rect(ctx, time_digits[hour / 10], GRect(Time_Digit[0].x, Time_Digit[0].y, Time_Digit[0].width, Time_Digit[0].height));
     }
@@ -444,6 +719,7 @@ static void minutes_layer_draw(Layer *layer, GContext *ctx) {
 }
 
 
+#if FEATURE_SECONDS
 // Drawing the seconds layer
 static void seconds_layer_draw(Layer *layer, GContext *ctx) {
     // Draw nothing if we're at zero
@@ -452,40 +728,192 @@ static void seconds_layer_draw(Layer *layer, GContext *ctx) {
         graphics_draw_rect(ctx, GRect(0, 0, current_time.tm_sec * Seconds_Width, Seconds_Height));
     }
 }
+#endif
+
+
+#if FEATURE_MONTH_GRID
+// Drawing the month grid layer
+static void month_layer_draw(Layer *layer, GContext *ctx) {
+    GRect bounds = layer_get_bounds(layer);
+    // Hide the time under the grid
+    graphics_context_set_fill_color(ctx, GColorBlack);
+    graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+
+    int16_t offset_x = (bounds.size.w - (Weekday_Nb * Month_Cell_Width)) / 2,
+            offset_y = (bounds.size.h - (calendar.month_rows * Month_Cell_Height)) / 2;
+    for (int16_t cell = 0; cell < calendar.month_rows * Weekday_Nb; cell++) {
+        if (calendar.month_mdays[cell] > 0) {
+            GRect cell_rect = GRect(offset_x + ((cell % Weekday_Nb) * Month_Cell_Width), offset_y + ((cell / Weekday_Nb) * Month_Cell_Height), Month_Cell_Width, Month_Cell_Height);
+            weekday_digits_draw(ctx, calendar.month_mdays[cell], cell_rect, cell == calendar.month_today);
+        }
+    }
+}
+
+
+// Hide the month grid and give the time back
+static void month_grid_hide(void *data) {
+    month_timer = NULL;
+    layer_set_hidden(month_layer, true);
+    // The digits are only kept loaded for the weekday column
+    if (settings.weekday_format != INTL) {
+        weekday_digits_unload();
+    }
+}
+
+
+// Handle the tap event, showing the month grid for a little while
+static void handle_tap(AccelAxisType axis, int32_t direction) {
+    if (month_timer != NULL) {
+        // Already shown, keep it a little longer
+        app_timer_reschedule(month_timer, Month_Display_Ms);
+        return;
+    }
+    weekday_digits_load();
+    layer_set_hidden(month_layer, false);
+    month_timer = app_timer_register(Month_Display_Ms, month_grid_hide, NULL);
+}
+#endif
+
+
+#if FEATURE_STEPS
+// Read today's steps, only redrawing the rail when its filled width actually changes
+static void steps_update(void) {
+    steps_reads++;
+    int32_t goal = settings.step_goal > 0 ? settings.step_goal : Steps_Default_Goal,
+            steps = health_service_sum_today(HealthMetricStepCount);
+    if (steps > goal) {
+        steps = goal;
+    }
+    int16_t width = Seconds_BG_Layer_Dim.width * steps / goal;
+    if (width != steps_width) {
+        steps_width = width;
+        steps_redraws++;
+        layer_mark_dirty(seconds_bg_layer);
+    }
+}
+
+
+// Handle the health events: movement, new day or history change
+static void handle_health(HealthEventType event, void *context) {
+    steps_events++;
+    switch (event) {
+        case HealthEventSignificantUpdate:
+        case HealthEventMovementUpdate:
+            steps_update();
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
+
+#if FEATURE_SECOND_TZ
+// Load the second time zone transitions from the bytes sent by the phone
+static void second_tz_load(const uint8_t *data, int16_t length) {
+    second_tz_nb = 0;
+    for (int16_t i = 0; i + SECOND_TZ_TRANSITION_SIZE <= length && second_tz_nb < SECOND_TZ_TRANSITIONS_MAX; i += SECOND_TZ_TRANSITION_SIZE) {
+        second_tz_times[second_tz_nb] = data[i] | (data[i + 1] << 8) | (data[i + 2] << 16) | ((uint32_t)data[i + 3] << 24);
+        second_tz_offsets[second_tz_nb] = (int16_t)(data[i + 4] | (data[i + 5] << 8));
+        second_tz_nb++;
+    }
+}
+
+
+// Apply the second time zone's current offset to now (UTC), only redrawing the date if it shows something that changed
+static void second_tz_update(time_t now) {
+    int16_t hour = -1,
+            minute = -1;
+    if (second_tz_nb > 0) {
+        // The transitions are sorted, use the last one that already happened (or the first one if none did yet)
+        int16_t i = 0;
+        while (i + 1 < second_tz_nb && second_tz_times[i + 1] <= (uint32_t)now) {
+            i++;
+        }
+        int32_t minutes = (((int32_t)(now / 60) + second_tz_offsets[i]) % (24 * 60) + (24 * 60)) % (24 * 60);
+        hour = minutes / 60;
+        minute = minutes % 60;
+    }
+
+    bool changed = false;
+    if ((hour != second_tz_hour) && (strchr(settings.date_format, 'H') || strchr(settings.date_format, 'h'))) {
+        changed = true;
+    }
+    if ((minute != second_tz_minute) && strchr(settings.date_format, 'N')) {
+        changed = true;
+    }
+    second_tz_hour = hour;
+    second_tz_minute = minute;
+    if (changed) {
+        layer_mark_dirty(date_layer);
+    }
+}
+#endif
 
 
 // Handle the tick event
 static void handle_tick(struct tm *tick_time, TimeUnits units_changed) {
     // Populate the global variable with the current time to have it when painting
+    struct tm previous_time = current_time;
     current_time = *tick_time;
 
+    // Compare with the previous tick instead of trusting units_changed, so that missed ticks and clock jumps
+    // (DST, time zone change, time set by hand) refresh exactly the layers whose displayed value changed
+    bool date_changed = (current_time.tm_mday != previous_time.tm_mday) || (current_time.tm_mon != previous_time.tm_mon) || (current_time.tm_year != previous_time.tm_year),
+         hour_changed = current_time.tm_hour != previous_time.tm_hour,
+         minute_changed = current_time.tm_min != previous_time.tm_min;
+
     // Mark the relevant layers for refresh
-    if (settings.display_seconds) {
+#if FEATURE_SECONDS
+    if (settings.display_seconds && current_time.tm_sec != previous_time.tm_sec) {
         layer_mark_dirty(seconds_layer);
     }
-    if (current_time.tm_sec == 0) {
+#endif
+#if FEATURE_SECOND_TZ
+    if (minute_changed || hour_changed || date_changed) {
+        second_tz_update(time(NULL));
+    }
+#endif
+    if (minute_changed) {
         layer_mark_dirty(minutes_layer);
-        if (current_time.tm_min == 0) {
+        // Not tied to the hour changing: when DST ends, 01:59 is followed by 01:00 again
+        if (settings.vibrate_on_hour && current_time.tm_min == 0) {
+            vibes_short_pulse();
+        }
+    }
+    if (hour_changed) {
+        // 0 and 12 look the same on a 12-hour clock, only the AM/PM arrow changes then
+        if (display_hour(current_time.tm_hour) != display_hour(previous_time.tm_hour)) {
             layer_mark_dirty(hours_layer);
-            if (settings.vibrate_on_hour) {
-                vibes_short_pulse();
-            }
-            if (!clock_is_24h_style() && current_time.tm_hour % 12 == 0) {
-                layer_mark_dirty(ampm_layer);
-            }
-            if (current_time.tm_hour == 0) {
-                layer_mark_dirty(weekday_layer);
-                layer_mark_dirty(date_layer);
-            }
         }
+#if FEATURE_AMPM
+        if (!clock_is_24h_style() && (current_time.tm_hour < 12) != (previous_time.tm_hour < 12)) {
+            layer_mark_dirty(ampm_layer);
+        }
+#endif
+    }
+    if (date_changed) {
+#if FEATURE_WEEKDAY_DIGITS
+        calendar_update(&calendar, &current_time, settings.weekday_first_day);
+#endif
+#if FEATURE_MONTH_GRID
+        layer_mark_dirty(month_layer);
+#endif
+        layer_mark_dirty(weekday_layer);
+        layer_mark_dirty(date_layer);
     }
 }
 
+#if FEATURE_BATTERY
 // Handle the battery change event
 static void handle_battery(BatteryChargeState charge_state) {
     battery_state = charge_state.charge_percent;
-    layer_mark_dirty(seconds_bg_layer);
+    // The step progress takes the battery's place when shown
+    if (!settings.display_steps) {
+        layer_mark_dirty(seconds_bg_layer);
+    }
 }
+#endif
 
 
 // Get our settings from the phone, locally or use the defaults
@@ -502,6 +930,8 @@ void init_settings(void) {
         newSettings.weekday_first_day = persist_read_int(Key_Weekday_First_Day);
         persist_read_string(Key_Date_Format, newSettings.date_format, 10);
         newSettings.display_battery = persist_read_bool(Key_Display_Battery);
+        newSettings.display_steps = persist_read_bool(Key_Display_Steps);
+        newSettings.step_goal = persist_read_int(Key_Step_Goal);
     }
     else {
         // Otherwise, use the defaults
@@ -512,68 +942,63 @@ void init_settings(void) {
         newSettings.weekday_first_day = 0;
         strncpy(newSettings.date_format, "", 10);
         newSettings.display_battery = true;
+        newSettings.display_steps = false;
+        newSettings.step_goal = Steps_Default_Goal;
     }
 
+    // Ignore the settings for features this build doesn't include
+    newSettings.weekday_format = supported_weekday_format(newSettings.weekday_format);
+#if !FEATURE_SECONDS
+    newSettings.display_seconds = false;
+#endif
+#if !FEATURE_BATTERY
+    newSettings.display_battery = false;
+#endif
+#if !FEATURE_STEPS
+    newSettings.display_steps = false;
+#endif
+
     // First, we unsubscribe from the tick timer service to stop all possible concurrent calls
     tick_timer_service_unsubscribe();
 
+#if FEATURE_MONTH_GRID
+    // The month grid may be using resources we're about to change
+    if (month_timer != NULL) {
+        app_timer_cancel(month_timer);
+        month_grid_hide(NULL);
+    }
+#endif
+
     if ((!settings_initialized) || (settings.weekday_format != newSettings.weekday_format)) {
         if (settings_initialized) {
             // If we previously had ressources loaded and we're changing the weekday format, unload them
+#if FEATURE_WEEKDAY_INTL
             if (settings.weekday_format == INTL) {
-                for (int16_t i = 0; i < 10; i++) {
-                    gbitmap_destroy(weekday_digits[i]);
-                }
+                weekday_digits_unload();
             }
-            else {
-                for (int16_t i = 0; i < 7; i++) {
-                    gbitmap_destroy(weekday_names[i]);
-                }
+#endif
+#if FEATURE_WEEKDAY_NAMES
+            // The letters are shared by all languages, they're only unloaded when going back to digits
+            if (settings.weekday_format != INTL && newSettings.weekday_format == INTL) {
+                weekday_letters_unload();
             }
+#endif
         }
+#if FEATURE_WEEKDAY_NAMES
+        bool letters_loaded = settings_initialized && settings.weekday_format != INTL;
+#endif
         settings.weekday_format=newSettings.weekday_format;
         // Load the appropriate ressources
-        switch (settings.weekday_format) {
-            case INTL:
-                weekday_digits[0] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_0);
-                weekday_digits[1] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_1);
-                weekday_digits[2] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_2);
-                weekday_digits[3] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_3);
-                weekday_digits[4] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_4);
-                weekday_digits[5] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_5);
-                weekday_digits[6] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_6);
-                weekday_digits[7] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_7);
-                weekday_digits[8] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_8);
-                weekday_digits[9] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_9);
-                break;
-            case EN:
-                weekday_names[0] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_EN_0);
-                weekday_names[1] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_EN_1);
-                weekday_names[2] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_EN_2);
-                weekday_names[3] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_EN_3);
-                weekday_names[4] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_EN_4);
-                weekday_names[5] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_EN_5);
-                weekday_names[6] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_EN_6);
-                break;
-            case FR:
-                weekday_names[0] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_FR_0);
-                weekday_names[1] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_FR_1);
-                weekday_names[2] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_FR_2);
-                weekday_names[3] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_FR_3);
-                weekday_names[4] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_FR_4);
-                weekday_names[5] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_FR_5);
-                weekday_names[6] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_FR_6);
-                break;
-            case ES:
-                weekday_names[0] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_ES_0);
-                weekday_names[1] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_ES_1);
-                weekday_names[2] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_ES_2);
-                weekday_names[3] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_ES_3);
-                weekday_names[4] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_ES_4);
-                weekday_names[5] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_ES_5);
-                weekday_names[6] = gbitmap_create_with_resource(RESOURCE_ID_WEEKDAY_ES_6);
-                break;
+#if FEATURE_WEEKDAY_INTL
+        if (settings.weekday_format == INTL) {
+            weekday_digits_load();
+        }
+#endif
+#if FEATURE_WEEKDAY_NAMES
+        if (settings.weekday_format != INTL && !letters_loaded) {
+            weekday_letters_load();
         }
+#endif
         // Make sure we redraw the weekday with the new settings
         layer_mark_dirty(weekday_layer);
         layer_mark_dirty(weekday_bg_layer);
@@ -587,6 +1012,9 @@ void init_settings(void) {
     }
     if ((!settings_initialized) || (settings.weekday_first_day != newSettings.weekday_first_day)) {
         settings.weekday_first_day=newSettings.weekday_first_day;
+#if FEATURE_WEEKDAY_DIGITS
+        calendar_update(&calendar, &current_time, settings.weekday_first_day);
+#endif
         layer_mark_dirty(weekday_layer);
     }
     if ((!settings_initialized) || (strcmp(settings.date_format, newSettings.date_format) != 0)) {
@@ -599,18 +1027,42 @@ void init_settings(void) {
             battery_state_service_unsubscribe();
         }
         settings.display_battery=newSettings.display_battery;
+#if FEATURE_BATTERY
         if (settings.display_battery) {
             // We're now showing battery stats, get an initial state and subscribe to the service
             BatteryChargeState battery_peek = battery_state_service_peek();
             battery_state = battery_peek.charge_percent;
             battery_state_service_subscribe(handle_battery);
         }
+#endif
+#if FEATURE_SECONDS
         layer_mark_dirty(seconds_layer);
+#endif
+        layer_mark_dirty(seconds_bg_layer);
+    }
+    if ((!settings_initialized) || (settings.display_steps != newSettings.display_steps) || (settings.step_goal != newSettings.step_goal)) {
+#if FEATURE_STEPS
+        if ((settings_initialized) && (settings.display_steps)) {
+            // We were previously showing step progress, unsubscribe from the service
+            health_service_events_unsubscribe();
+        }
+#endif
+        settings.display_steps=newSettings.display_steps;
+        settings.step_goal=newSettings.step_goal;
+#if FEATURE_STEPS
+        if (settings.display_steps) {
+            // We're now showing step progress, get an initial count and subscribe to the service
+            steps_update();
+            health_service_events_subscribe(handle_health, NULL);
+        }
+#endif
         layer_mark_dirty(seconds_bg_layer);
     }
     if ((!settings_initialized) || (settings.display_seconds != newSettings.display_seconds)) {
         settings.display_seconds=newSettings.display_seconds;
+#if FEATURE_SECONDS
         layer_mark_dirty(seconds_layer);
+#endif
         layer_mark_dirty(seconds_bg_layer);
     }
 
@@ -638,15 +1090,22 @@ void in_received_handler(DictionaryIterator *received, void *context) {
     APP_LOG(APP_LOG_LEVEL_INFO, "Received Message - Success");
     bool settingsUpdated = false;
     Settings_Type newSettings = settings;
-    int16_t value_num;
+    int32_t value_num;
     Tuple *tuple = dict_read_first(received);
     while (tuple) {
         if (tuple->type == TUPLE_CSTRING) {
             value_num = string_to_int(tuple->value->cstring);
         }
-        else {
+        else if (tuple->length == 1) {
+            value_num = tuple->value->int8;
+        }
+        else if (tuple->length == 2) {
             value_num = tuple->value->int16;
         }
+        else {
+            // The phone sends numbers as 4-byte integers, e.g. a step goal over 32767
+            value_num = tuple->value->int32;
+        }
         switch (tuple->key) {
             case Weekday_Format:
                 newSettings.weekday_format = value_num;
@@ -676,6 +1135,27 @@ void in_received_handler(DictionaryIterator *received, void *context) {
                 newSettings.display_battery = value_num;
                 settingsUpdated = true;
                 break;
+            case Display_Steps:
+                newSettings.display_steps = value_num;
+                settingsUpdated = true;
+                break;
+            case Step_Goal:
+                newSettings.step_goal = value_num < 1 ? 1 : (value_num > Steps_Max_Goal ? Steps_Max_Goal : value_num);
+                settingsUpdated = true;
+                break;
+#if FEATURE_SECOND_TZ
+            case Second_TZ_Table:
+                // Not a setting, the phone resends it when the zone changes or before it runs out
+                second_tz_load(tuple->value->data, tuple->length);
+                if (tuple->length > 0) {
+                    persist_write_data(Key_Second_TZ_Table, tuple->value->data, tuple->length);
+                }
+                else {
+                    persist_delete(Key_Second_TZ_Table);
+                }
+                second_tz_update(time(NULL));
+                break;
+#endif
         }
         tuple = dict_read_next(received);
     }
@@ -688,6 +1168,8 @@ void in_received_handler(DictionaryIterator *received, void *context) {
         persist_write_int(Key_Weekday_First_Day, newSettings.weekday_first_day);
         persist_write_string(Key_Date_Format, newSettings.date_format);
         persist_write_bool(Key_Display_Battery, newSettings.display_battery);
+        persist_write_bool(Key_Display_Steps, newSettings.display_steps);
+        persist_write_int(Key_Step_Goal, newSettings.step_goal);
         init_settings();
     }
 }
@@ -736,17 +1218,28 @@ void handle_init(void) {
     layer_set_update_proc(minutes_layer, minutes_layer_draw);
     layer_add_child(window_layer, minutes_layer);
 
+#if FEATURE_AMPM
     ampm_layer = layer_create(GRect(AmPm_Layer_Dim.x, AmPm_Layer_Dim.y, AmPm_Layer_Dim.width, AmPm_Layer_Dim.height));
     layer_set_update_proc(ampm_layer, ampm_layer_draw);
     layer_add_child(window_layer, ampm_layer);
+#endif
 
     seconds_bg_layer = layer_create(GRect(Seconds_BG_Layer_Dim.x, Seconds_BG_Layer_Dim.y, Seconds_BG_Layer_Dim.width, Seconds_BG_Layer_Dim.height));
     layer_set_update_proc(seconds_bg_layer, seconds_bg_layer_draw);
     layer_add_child(window_layer, seconds_bg_layer);
 
+#if FEATURE_SECONDS
     seconds_layer = layer_create(GRect(Seconds_Layer_Dim.x, Seconds_Layer_Dim.y, Seconds_Layer_Dim.width, Seconds_Layer_Dim.height));
     layer_set_update_proc(seconds_layer, seconds_layer_draw);
     layer_add_child(seconds_bg_layer, seconds_layer);
+#endif
+
+#if FEATURE_MONTH_GRID
+    month_layer = layer_create(GRect(Month_Layer_Dim.x, Month_Layer_Dim.y, Month_Layer_Dim.width, Month_Layer_Dim.height));
+    layer_set_update_proc(month_layer, month_layer_draw);
+    layer_set_hidden(month_layer, true);
+    layer_add_child(window_layer, month_layer);
+#endif
 
     // Bitmap resources
     time_digits[0] = gbitmap_create_with_resource(RESOURCE_ID_TIME_0);
@@ -774,6 +1267,15 @@ void handle_init(void) {
     // Initialize the setting specific items
     init_settings();
 
+#if FEATURE_SECOND_TZ
+    // Use the last transitions we got until the phone sends fresh ones
+    if (persist_exists(Key_Second_TZ_Table)) {
+        uint8_t second_tz_data[SECOND_TZ_TRANSITION_SIZE * SECOND_TZ_TRANSITIONS_MAX];
+        second_tz_load(second_tz_data, persist_read_data(Key_Second_TZ_Table, second_tz_data, sizeof(second_tz_data)));
+        second_tz_update(timer);
+    }
+#endif
+
     // Registering the messaging handlers
     app_message_register_inbox_received(in_received_handler);
     app_message_register_inbox_dropped(in_dropped_handler);
@@ -783,32 +1285,60 @@ void handle_init(void) {
     const uint32_t inbound_size = app_message_inbox_size_maximum();
     const uint32_t outbound_size = app_message_outbox_size_maximum();
     app_message_open(inbound_size, outbound_size);
+
+#if FEATURE_MONTH_GRID
+    accel_tap_service_subscribe(handle_tap);
+#endif
+
+    APP_LOG(APP_LOG_LEVEL_INFO, "Startup (%s profile) - Heap %u bytes used, %u bytes free", FEATURE_PROFILE, (unsigned int)heap_bytes_used(), (unsigned int)heap_bytes_free());
 }
 
 
 // destroy, destroy, DESTROY!
 void handle_deinit(void) {
+#if FEATURE_STEPS
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Steps - %lu events, %lu reads, %lu redraws", steps_events, steps_reads, steps_redraws);
+    if (settings.display_steps) {
+        health_service_events_unsubscribe();
+    }
+#endif
+
+#if FEATURE_MONTH_GRID
+    accel_tap_service_unsubscribe();
+    if (month_timer != NULL) {
+        app_timer_cancel(month_timer);
+        month_grid_hide(NULL);
+    }
+#endif
+
     // Bitmap resources
     for (int16_t i = 0; i < 10; i++) {
         gbitmap_destroy(time_digits[i]);
         gbitmap_destroy(date_digits[i]);
-        if (settings.weekday_format == INTL) {
-            gbitmap_destroy(weekday_digits[i]);
-        }
     }
+#if FEATURE_WEEKDAY_DIGITS
+    weekday_digits_unload();
+#endif
+#if FEATURE_WEEKDAY_NAMES
     if (settings.weekday_format != INTL) {
-        for (int16_t i = 0; i < 7; i++) {
-            gbitmap_destroy(weekday_names[i]);
-        }
+        weekday_letters_unload();
     }
+#endif
 
     // Display layers
     layer_destroy(weekday_layer);
     layer_destroy(date_layer);
+#if FEATURE_AMPM
     layer_destroy(ampm_layer);
+#endif
     layer_destroy(hours_layer);
     layer_destroy(minutes_layer);
+#if FEATURE_SECONDS
     layer_destroy(seconds_layer);
+#endif
+#if FEATURE_MONTH_GRID
+    layer_destroy(month_layer);
+#endif
 
     // Background layers
     layer_destroy(weekday_bg_layer);
@@ -824,4 +1354,5 @@ int main(void) {
     handle_init();
     app_event_loop();
     handle_deinit();
+    return 0;
 }
@@ -0,0 +1,75 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ */
+
+#include <string.h>
+#include "calendar.h"
+
+
+static const int16_t mday_max[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+
+// Check for leap years, with the 100s and 400s rules
+bool is_leap_year(int16_t year) {
+    return (year % 4 == 0) && ((year % 100 != 0) || (year % 400 == 0));
+}
+
+
+// Number of days in a month (0 to 11)
+int16_t days_in_month(int16_t year, int16_t month) {
+    if ((month == 1) && is_leap_year(year)) {
+        return 29;
+    }
+    return mday_max[month];
+}
+
+
+// Compute the days shown by the weekday column and the month grid, only needed when the date or the first day of the week changes
+void calendar_update(Calendar_Type *calendar, const struct tm *date, int16_t first_day) {
+    int16_t year = date->tm_year + 1900;
+    int16_t days_nb = days_in_month(year, date->tm_mon);
+    // watch out for January, the previous month is in the previous year
+    int16_t previous_days_nb = date->tm_mon == 0 ? days_in_month(year - 1, 11) : days_in_month(year, date->tm_mon - 1);
+    // Day of the week, handling displaying a day other than Sunday as the first day
+    int16_t wday = (date->tm_wday + (Weekday_Nb - first_day)) % Weekday_Nb;
+
+    for (int16_t position = 0; position < Weekday_Nb; position++) {
+        // Difference between the position and the current weekday
+        int16_t mday_delta = position - wday;
+        if (mday_delta < -Weekday_Max_Delta) {
+            // If the day delta is too low, we actually show a day in the future instead  (Sunday to Tuesday when currently Thursday or later in the week)
+            mday_delta += Weekday_Nb;
+        }
+        else if (mday_delta > Weekday_Max_Delta) {
+            // If the day delta is too high, we actually show a day in the past instead (Thursday to Saturday when currently Tuesday or earlier in the week)
+            mday_delta -= Weekday_Nb;
+        }
+
+        int16_t mday = date->tm_mday + mday_delta;
+        if (mday < 1) {
+            // If we're in the past and accross a month's start, count from the last day of the previous month
+            mday += previous_days_nb;
+        }
+        else if (mday > days_nb) {
+            // If we're in the future and past the current month's end, start from 1 in the next month
+            mday -= days_nb;
+        }
+        calendar->week_deltas[position] = mday_delta;
+        calendar->week_mdays[position] = mday;
+    }
+
+    // The month grid starts on the first day of the week, in the column of the 1st of the month
+    int16_t first_column = (wday - ((date->tm_mday - 1) % Weekday_Nb) + Weekday_Nb) % Weekday_Nb;
+    memset(calendar->month_mdays, 0, sizeof(calendar->month_mdays));
+    for (int16_t mday = 1; mday <= days_nb; mday++) {
+        calendar->month_mdays[first_column + mday - 1] = mday;
+    }
+    calendar->month_rows = (first_column + days_nb + Weekday_Nb - 1) / Weekday_Nb;
+    calendar->month_today = first_column + date->tm_mday - 1;
+}
@@ -0,0 +1,41 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ *
+ * Calendar table shared by the weekday column and the month grid.  Only uses
+ * the C library, so tools/test_calendar.c can check it on the host.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+
+static const int16_t Weekday_Nb = 7,
+                     Weekday_Max_Delta = 3;
+
+// Days shown by the weekday column and the month grid, computed once a day
+typedef struct Calendar_Type {
+    int8_t week_mdays[7];
+    int8_t week_deltas[7];
+    uint8_t month_mdays[42];
+    int8_t month_rows;
+    int8_t month_today;
+} Calendar_Type;
+
+
+// Check for leap years, with the 100s and 400s rules
+bool is_leap_year(int16_t year);
+
+// Number of days in a month (0 to 11)
+int16_t days_in_month(int16_t year, int16_t month);
+
+// Compute the days shown by the weekday column and the month grid, with first_day (0 is Sunday) in the top slot
+void calendar_update(Calendar_Type *calendar, const struct tm *date, int16_t first_day);
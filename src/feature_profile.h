@@ -0,0 +1,19 @@
+/*
+ * Big H
+ * Feature profile, generated by tools/profile.py
+ *
+ * Profile: full
+ */
+
+#define FEATURE_PROFILE "full"
+
+#define FEATURE_SECONDS 1
+#define FEATURE_BATTERY 1
+#define FEATURE_AMPM 1
+#define FEATURE_WEEKDAY_INTL 1
+#define FEATURE_WEEKDAY_EN 1
+#define FEATURE_WEEKDAY_ES 1
+#define FEATURE_WEEKDAY_FR 1
+#define FEATURE_MONTH_GRID 1
+#define FEATURE_STEPS 1
+#define FEATURE_SECOND_TZ 1
@@ -1,6 +1,97 @@
+// Second time zone: UTC offset transitions for the next year, at most 32 (see SECOND_TZ_TRANSITIONS_MAX)
+var SECOND_TZ_TRANSITIONS_MAX = 32;
+var SECOND_TZ_DAYS = 366;
+// The watch keeps its table, it is only rebuilt when the zone changes or this close to running out
+var SECOND_TZ_REFRESH_DAYS = 30;
+
+
+// UTC offset in minutes of the time zone at the given time
+function secondTzOffset(formatter, time) {
+  var parts = {};
+  formatter.formatToParts(new Date(time)).forEach(function(part) {
+    parts[part.type] = parseInt(part.value, 10);
+  });
+  var local = Date.UTC(parts.year, parts.month - 1, parts.day, parts.hour % 24, parts.minute);
+  return Math.round((local - Math.floor(time / 60000) * 60000) / 60000);
+}
+
+
+// Transitions table sent to the watch: UTC time in seconds (4 bytes) and offset in minutes (2 bytes), little-endian,
+// along with the time it is valid until (never rebuilt for an empty or unusable zone)
+function secondTzTable(zone) {
+  var bytes = [];
+  if (!zone) {
+    return { bytes: bytes, until: Infinity };
+  }
+  var formatter;
+  try {
+    formatter = new Intl.DateTimeFormat('en-US', {
+      timeZone: zone, hour12: false,
+      year: 'numeric', month: 'numeric', day: 'numeric', hour: 'numeric', minute: 'numeric'
+    });
+  }
+  catch (error) {
+    console.log("Unknown second time zone: " + zone);
+    return { bytes: bytes, until: Infinity };
+  }
+  if (typeof formatter.formatToParts != "function") {
+    console.log("Second time zone not supported by this phone");
+    return { bytes: bytes, until: Infinity };
+  }
+
+  var time = Math.floor(Date.now() / 60000) * 60000;
+  var offset = secondTzOffset(formatter, time);
+  var transitions = [[time, offset]];
+  // Look for offset changes a day at a time, then narrow each one down to the minute
+  for (var day = 1; day <= SECOND_TZ_DAYS && transitions.length < SECOND_TZ_TRANSITIONS_MAX; day++) {
+    var next = time + 86400000;
+    var nextOffset = secondTzOffset(formatter, next);
+    if (nextOffset != offset) {
+      var low = time, high = next;
+      while (high - low > 60000) {
+        var middle = low + Math.floor((high - low) / 120000) * 60000;
+        if (secondTzOffset(formatter, middle) == offset) {
+          low = middle;
+        }
+        else {
+          high = middle;
+        }
+      }
+      transitions.push([high, nextOffset]);
+    }
+    time = next;
+    offset = nextOffset;
+  }
+
+  transitions.forEach(function(transition) {
+    var seconds = Math.floor(transition[0] / 1000);
+    bytes.push(seconds & 0xFF, (seconds >>> 8) & 0xFF, (seconds >>> 16) & 0xFF, (seconds >>> 24) & 0xFF);
+    bytes.push(transition[1] & 0xFF, (transition[1] >> 8) & 0xFF);
+  });
+  return { bytes: bytes, until: time };
+}
+
+
+// Remember the table the watch has once it got it
+function secondTzSent(zone, table) {
+  localStorage.setItem("second_tz_sent", zone);
+  localStorage.setItem("second_tz_until", table.until);
+}
+
+
 Pebble.addEventListener("ready",
   function(e) {
     console.log("JavaScript app ready and running!");
+    // Refresh the watch's transitions if the zone changed or they are about to run out, they only cover the next year
+    var zone = localStorage.getItem("second_tz") || "";
+    var sent = localStorage.getItem("second_tz_sent") || "";
+    var until = parseFloat(localStorage.getItem("second_tz_until")) || 0;
+    if (zone != sent || (zone && Date.now() > until - SECOND_TZ_REFRESH_DAYS * 86400000)) {
+      var table = secondTzTable(zone);
+      Pebble.sendAppMessage({ "second_tz_table": table.bytes }, function(e) {
+        secondTzSent(zone, table);
+      });
+    }
   }
 );
 
@@ -19,7 +110,19 @@ Pebble.addEventListener("webviewclosed",
     console.log("Configuration window returned: " + JSON.stringify(settings));
     if (settings.saved) {
     	delete settings.saved;
-    	Pebble.sendAppMessage(settings);
+    	var zone, table;
+    	if ("second_tz" in settings) {
+    	  zone = settings.second_tz;
+    	  localStorage.setItem("second_tz", zone);
+    	  table = secondTzTable(zone);
+    	  settings.second_tz_table = table.bytes;
+    	  delete settings.second_tz;
+    	}
+    	Pebble.sendAppMessage(settings, function(e) {
+    	  if (table) {
+    	    secondTzSent(zone, table);
+    	  }
+    	});
     }
   }
-);
\ No newline at end of file
+);
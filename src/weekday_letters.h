@@ -0,0 +1,154 @@
+/*
+ * Big H
+ * Weekday letters, generated by tools/weekday_letters.py
+ */
+
+#define WEEKDAY_GLYPHS_NB 45
+
+// Position of each glyph in the RESOURCE_ID_WEEKDAY_LETTERS atlas
+static const Weekday_Glyph Weekday_Glyphs[WEEKDAY_GLYPHS_NB] = {
+    {0, 8, 13},
+    {8, 7, 10},
+    {15, 7, 10},
+    {22, 7, 14},
+    {29, 7, 10},
+    {36, 8, 14},
+    {44, 12, 13},
+    {56, 8, 10},
+    {64, 9, 13},
+    {73, 7, 10},
+    {80, 7, 10},
+    {87, 14, 13},
+    {101, 7, 14},
+    {108, 5, 10},
+    {113, 8, 13},
+    {121, 2, 14},
+    {123, 5, 13},
+    {128, 10, 15},
+    {138, 2, 16},
+    {140, 13, 11},
+    {153, 8, 11},
+    {161, 8, 11},
+    {169, 7, 11},
+    {176, 8, 16},
+    {184, 7, 11},
+    {191, 8, 15},
+    {199, 8, 11},
+    {207, 8, 16},
+    {215, 12, 15},
+    {227, 5, 11},
+    {232, 7, 15},
+    {239, 11, 15},
+    {250, 9, 15},
+    {259, 9, 13},
+    {268, 12, 10},
+    {280, 7, 14},
+    {287, 8, 13},
+    {295, 7, 14},
+    {302, 7, 10},
+    {309, 2, 14},
+    {311, 7, 13},
+    {318, 8, 10},
+    {326, 10, 13},
+    {336, 7, 14},
+    {343, 8, 14}
+};
+
+#if FEATURE_WEEKDAY_EN
+static const Weekday_Letter Weekday_Letters_EN[] = {
+    {0x0046, 14, 3, -13},
+    {0x004d, 6, 1, -13},
+    {0x0053, 0, 3, -13},
+    {0x0054, 8, 2, -13},
+    {0x0057, 11, 0, -13},
+    {0x0061, 4, 3, -10},
+    {0x0064, 3, 3, -14},
+    {0x0065, 9, 4, -10},
+    {0x0068, 12, 4, -14},
+    {0x0069, 15, 5, -14},
+    {0x006e, 2, 4, -10},
+    {0x006f, 7, 4, -10},
+    {0x0072, 13, 4, -10},
+    {0x0073, 10, 4, -10},
+    {0x0074, 16, 4, -13},
+    {0x0075, 1, 4, -10},
+    {0x0079, 5, 2, -10}
+};
+
+static const Weekday_Language Weekday_Language_EN = {
+    18,
+    Weekday_Letters_EN,
+    17,
+    {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"},
+    {45, 44, 35, 18, 26, 44, 26},
+    {0x38, 0x38, 0x70, 0x1c4, 0xe8, 0x00, 0xf2}
+};
+#endif
+
+#if FEATURE_WEEKDAY_FR
+static const Weekday_Letter Weekday_Letters_FR[] = {
+    {0x0044, 17, 2, -15},
+    {0x004a, 30, 3, -15},
+    {0x004c, 25, 3, -15},
+    {0x004d, 28, 1, -15},
+    {0x0053, 32, 3, -15},
+    {0x0056, 31, 1, -15},
+    {0x0061, 20, 4, -11},
+    {0x0063, 22, 4, -11},
+    {0x0064, 27, 2, -16},
+    {0x0065, 24, 3, -11},
+    {0x0068, 23, 3, -16},
+    {0x0069, 18, 5, -16},
+    {0x006d, 19, 1, -11},
+    {0x006e, 21, 2, -11},
+    {0x0072, 29, 4, -11},
+    {0x0075, 26, 3, -11}
+};
+
+static const Weekday_Language Weekday_Language_FR = {
+    21,
+    Weekday_Letters_FR,
+    16,
+    {"Dimanche", "Lundi", "Mardi", "Mercredi", "Jeudi", "Vendredi", "Samedi"},
+    {19, 49, 49, 19, 49, 19, 39},
+    {0x92, 0x1c, 0x1c, 0xf6, 0x1a, 0x00, 0x38}
+};
+#endif
+
+#if FEATURE_WEEKDAY_ES
+static const Weekday_Letter Weekday_Letters_ES[] = {
+    {0x0044, 33, 3, -13},
+    {0x004a, 40, 3, -13},
+    {0x004c, 36, 3, -13},
+    {0x004d, 6, 1, -13},
+    {0x0053, 0, 3, -13},
+    {0x0056, 42, 2, -13},
+    {0x0061, 4, 4, -10},
+    {0x0062, 44, 4, -14},
+    {0x0063, 38, 4, -10},
+    {0x0064, 3, 4, -14},
+    {0x0065, 9, 3, -10},
+    {0x0067, 35, 4, -10},
+    {0x0069, 15, 6, -14},
+    {0x006c, 39, 6, -14},
+    {0x006d, 34, 1, -10},
+    {0x006e, 2, 3, -10},
+    {0x006f, 7, 4, -10},
+    {0x0072, 13, 5, -10},
+    {0x0073, 10, 3, -10},
+    {0x0074, 16, 4, -13},
+    {0x0075, 1, 3, -10},
+    {0x0076, 41, 2, -10},
+    {0x00e1, 43, 4, -14},
+    {0x00e9, 37, 4, -14}
+};
+
+static const Weekday_Language Weekday_Language_ES = {
+    18,
+    Weekday_Letters_ES,
+    24,
+    {"Domingo", "Lunes", "Martes", "Mi\303\251rcoles", "Jueves", "Viernes", "S\303\241bado"},
+    {36, 54, 46, 18, 46, 36, 46},
+    {0x10, 0x00, 0x30, 0x180, 0x00, 0x74, 0x00}
+};
+#endif
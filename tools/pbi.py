@@ -0,0 +1,267 @@
+#!/usr/bin/env python
+#
+# Big H
+# Watchface for Pebble smartwatch
+#
+# https://github.com/samalander/big-h
+#
+# Licensed under the LGPLv3
+# see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+#
+# Converts resources/images/*.png into the native 1-bit bitmap format (.pbi)
+# so the watch loads the glyphs without decoding a PNG, and checks that the
+# pixels of each .pbi are identical to its .png.
+#
+# Usage: tools/pbi.py            convert all the images
+#        tools/pbi.py --check    only check the existing .pbi files
+#        tools/pbi.py --bench    compare the modelled watch memory cost of PNG and .pbi per glyph family
+
+from __future__ import print_function
+
+import fnmatch
+import glob
+import os
+import struct
+import sys
+import time
+import zlib
+
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+IMAGES = os.path.join(ROOT, 'resources', 'images')
+
+# Images which are never loaded as glyphs by the watchface (weekday names are
+# composed from weekday_letters.png, see tools/weekday_letters.py)
+SKIPPED = ['menu_icon_big_h.png', 'weekday_??_?.png']
+
+# Glyph families compared by --bench, as (family, file pattern)
+FAMILIES = [
+    ('date digits', 'date_?.png'),
+    ('time digits', 'time_?.png'),
+    ('weekday digits', 'weekday_?.png'),
+    ('weekday letters', 'weekday_letters.png'),
+]
+
+# Version 1, 1-bit format
+PBI_INFO_FLAGS = 1 << 12
+
+
+def read_png(path):
+    """Decodes a non-interlaced PNG into (width, height, rows of 0/1 pixels)"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s: not a PNG file' % path)
+
+    pos = 8
+    palette = None
+    compressed = b''
+    while pos < len(data):
+        length, chunk_type = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if chunk_type == b'IHDR':
+            width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif chunk_type == b'PLTE':
+            palette = [bytearray(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif chunk_type == b'IDAT':
+            compressed += chunk
+    if interlace:
+        raise ValueError('%s: interlaced PNG files are not supported' % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    pixel_bytes = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = bytearray(zlib.decompress(compressed))
+
+    rows = []
+    previous = bytearray(stride)
+    for y in range(height):
+        filter_type = raw[y * (stride + 1)]
+        line = raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)]
+        for x in range(stride):
+            a = line[x - pixel_bytes] if x >= pixel_bytes else 0
+            b = previous[x]
+            c = previous[x - pixel_bytes] if x >= pixel_bytes else 0
+            if filter_type == 1:
+                line[x] = (line[x] + a) & 0xff
+            elif filter_type == 2:
+                line[x] = (line[x] + b) & 0xff
+            elif filter_type == 3:
+                line[x] = (line[x] + (a + b) // 2) & 0xff
+            elif filter_type == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[x] = (line[x] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xff
+        previous = line
+
+        row = []
+        for x in range(width):
+            if depth < 8:
+                bit = x * depth
+                value = (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+                samples = [value]
+            else:
+                samples = [line[x * pixel_bytes + i * depth // 8] for i in range(channels)]
+            if color_type == 3:
+                r, g, b = palette[samples[0]]
+                alpha = 255
+            elif color_type in (0, 4):
+                r = g = b = samples[0] * 255 // ((1 << depth) - 1)
+                alpha = samples[1] if color_type == 4 else 255
+            else:
+                r, g, b = samples[:3]
+                alpha = samples[3] if color_type == 6 else 255
+            # Transparent pixels end up black, like the watch background
+            row.append(1 if alpha >= 128 and (r * 299 + g * 587 + b * 114) // 1000 >= 128 else 0)
+        rows.append(row)
+    return width, height, rows
+
+
+def write_pbi(path, width, height, rows):
+    row_size = (width + 31) // 32 * 4
+    data = bytearray(struct.pack('<HHhhhh', row_size, PBI_INFO_FLAGS, 0, 0, width, height))
+    for row in rows:
+        line = bytearray(row_size)
+        for x, pixel in enumerate(row):
+            # Leftmost pixel in the lowest bit
+            line[x // 8] |= pixel << (x % 8)
+        data += line
+    with open(path, 'wb') as f:
+        f.write(data)
+
+
+def read_pbi(path):
+    with open(path, 'rb') as f:
+        data = bytearray(f.read())
+    row_size, info_flags, _, _, width, height = struct.unpack('<HHhhhh', bytes(data[:12]))
+    if info_flags != PBI_INFO_FLAGS:
+        raise ValueError('%s: unsupported bitmap format 0x%04x' % (path, info_flags))
+    rows = []
+    for y in range(height):
+        line = data[12 + y * row_size:12 + (y + 1) * row_size]
+        rows.append([(line[x // 8] >> (x % 8)) & 1 for x in range(width)])
+    return width, height, rows
+
+
+def read_pbi_reference(path):
+    """Second .pbi decoder for the checks, written from the format rather than sharing write_pbi/read_pbi's code:
+    each row is a little-endian integer whose bit x is pixel x"""
+    with open(path, 'rb') as f:
+        data = bytearray(f.read())
+    row_size = data[0] | data[1] << 8
+    info_flags = data[2] | data[3] << 8
+    width = data[8] | data[9] << 8
+    height = data[10] | data[11] << 8
+    if info_flags != 0x1000 or row_size != (width + 31) // 32 * 4 or len(data) != 12 + row_size * height:
+        raise ValueError('%s: malformed 1-bit bitmap' % path)
+    rows = []
+    for y in range(height):
+        value = 0
+        for i in range(row_size):
+            value |= data[12 + y * row_size + i] << (8 * i)
+        rows.append([1 if value & (1 << x) else 0 for x in range(width)])
+    return width, height, rows
+
+
+def checksum(width, height, rows):
+    return zlib.crc32(struct.pack('<hh', width, height) + bytearray(pixel for row in rows for pixel in row)) & 0xffffffff
+
+
+def png_files():
+    return sorted(path for path in glob.glob(os.path.join(IMAGES, '*.png')) if not any(fnmatch.fnmatch(os.path.basename(path), pattern) for pattern in SKIPPED))
+
+
+def convert(check_only):
+    errors = 0
+    for png_path in png_files():
+        pbi_path = png_path[:-len('.png')] + '.pbi'
+        png_image = read_png(png_path)
+        if not check_only:
+            write_pbi(pbi_path, *png_image)
+        if not os.path.exists(pbi_path):
+            print('%s: missing' % os.path.relpath(pbi_path, ROOT))
+            errors += 1
+            continue
+        expected, actual = checksum(*png_image), checksum(*read_pbi_reference(pbi_path))
+        if expected != actual:
+            print('%s: pixels differ from the PNG (%08x != %08x)' % (os.path.relpath(pbi_path, ROOT), actual, expected))
+            errors += 1
+    print('%d images, %d errors' % (len(png_files()), errors))
+    return 1 if errors else 0
+
+
+def host_time(load, paths, iterations):
+    start = time.time()
+    for _ in range(iterations):
+        for path in paths:
+            load(path)
+    return (time.time() - start) / (iterations * len(paths))
+
+
+def bitmap_size(width, height):
+    # 1-bit rows are padded to 4 bytes
+    return (width + 31) // 32 * 4 * height
+
+
+def png_watch_model(path):
+    """Modelled watch heap spike while loading a PNG resource: the compressed file, the inflate window,
+    the inflated (still filtered) scanlines and the final bitmap, all allocated at once"""
+    with open(path, 'rb') as f:
+        data = f.read()
+    width, height, depth, color_type = struct.unpack('>IIBB', data[16:26])
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    pos = 8
+    while pos < len(data):
+        length, chunk_type = struct.unpack('>I4s', data[pos:pos + 8])
+        if chunk_type == b'IDAT':
+            # The zlib header gives the window size
+            window = 1 << ((bytearray(data[pos + 8:pos + 9])[0] >> 4) + 8)
+            break
+        pos += 12 + length
+    scanlines = height * ((width * channels * depth + 7) // 8 + 1)
+    return len(data) + window + scanlines + bitmap_size(width, height)
+
+
+def pbi_watch_model(path):
+    """Modelled watch heap spike while loading a .pbi resource: its pixels are read straight into the bitmap"""
+    width, height = read_pbi_reference(path)[:2]
+    return bitmap_size(width, height)
+
+
+def bench(iterations=20):
+    families = []
+    for family, pattern in FAMILIES:
+        png_paths = [path for path in png_files() if fnmatch.fnmatch(os.path.basename(path), pattern)]
+        if png_paths:
+            families.append((family, png_paths))
+
+    print('Watch memory (model, bytes): load spike of the largest glyph and resident bitmaps of the whole family')
+    print('%-16s %6s %12s %12s %12s %12s %12s' % ('family', 'images', 'png file', 'pbi file', 'png spike', 'pbi spike', 'resident'))
+    for family, png_paths in families:
+        pbi_paths = [path[:-len('.png')] + '.pbi' for path in png_paths]
+        print('%-16s %6d %12d %12d %12d %12d %12d' % (family, len(png_paths),
+              sum(os.path.getsize(path) for path in png_paths), sum(os.path.getsize(path) for path in pbi_paths),
+              max(png_watch_model(path) for path in png_paths), max(pbi_watch_model(path) for path in pbi_paths),
+              sum(pbi_watch_model(path) for path in pbi_paths)))
+
+    print('')
+    print('Host decoding time (Python, not representative of the watch)')
+    print('%-16s %12s %12s' % ('family', 'png us/img', 'pbi us/img'))
+    for family, png_paths in families:
+        pbi_paths = [path[:-len('.png')] + '.pbi' for path in png_paths]
+        print('%-16s %12.1f %12.1f' % (family, host_time(read_png, png_paths, iterations) * 1e6, host_time(read_pbi, pbi_paths, iterations) * 1e6))
+    return 0
+
+
+def main(args):
+    if args == ['--bench']:
+        return bench()
+    if args in ([], ['--check']):
+        return convert(args == ['--check'])
+    print('Usage: %s [--check|--bench]' % sys.argv[0], file=sys.stderr)
+    return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
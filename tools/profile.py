@@ -0,0 +1,177 @@
+#!/usr/bin/env python
+#
+# Big H
+# Watchface for Pebble smartwatch
+#
+# https://github.com/samalander/big-h
+#
+# Licensed under the LGPLv3
+# see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+#
+# Selects a feature profile: writes src/feature_profile.h, the weekday letter
+# atlas of its languages and the matching appinfo.json media list,
+# capabilities and message keys, then optionally builds and reports the sizes.
+#
+# Usage: tools/profile.py [--build] <profile>
+
+from __future__ import print_function
+
+import glob
+import os
+import re
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import weekday_letters
+from pbi import read_png, write_pbi
+
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+
+FEATURES = ['SECONDS', 'BATTERY', 'AMPM', 'WEEKDAY_INTL', 'WEEKDAY_EN', 'WEEKDAY_ES', 'WEEKDAY_FR', 'MONTH_GRID', 'STEPS', 'SECOND_TZ']
+
+PROFILES = {
+    'full': FEATURES,
+    'minimal': ['AMPM', 'WEEKDAY_INTL'],
+    'en': ['SECONDS', 'BATTERY', 'AMPM', 'WEEKDAY_EN', 'MONTH_GRID', 'STEPS', 'SECOND_TZ'],
+    'fr': ['SECONDS', 'BATTERY', 'AMPM', 'WEEKDAY_FR', 'MONTH_GRID', 'STEPS', 'SECOND_TZ'],
+    'es': ['SECONDS', 'BATTERY', 'AMPM', 'WEEKDAY_ES', 'MONTH_GRID', 'STEPS', 'SECOND_TZ'],
+}
+
+# Message keys as (name, key, feature needing them) (None: always needed), see the Settings_Keys in src/big-h.c
+APP_KEYS = [
+    ('weekday_format', 1, None),
+    ('vibrate_on_hour', 2, None),
+    ('display_seconds', 3, None),
+    ('leading_zero', 4, None),
+    ('weekday_first_day', 5, None),
+    ('date_format', 6, None),
+    ('display_battery', 7, None),
+    ('display_steps', 8, 'STEPS'),
+    ('step_goal', 9, 'STEPS'),
+    ('second_tz_table', 10, 'SECOND_TZ'),
+]
+
+# Capabilities as (name, feature needing them)
+CAPABILITIES = [
+    ('configurable', None),
+    ('health', 'STEPS'),
+]
+
+
+# Glyph resources as (name, file), grouped by the feature needing them (None: always needed)
+def resources(feature):
+    if feature is None:
+        return [('DATE_%d' % i, 'images/date_%d.pbi' % i) for i in range(10)] + \
+               [('TIME_%d' % i, 'images/time_%d.pbi' % i) for i in range(10)]
+    if feature in ('WEEKDAY_INTL', 'MONTH_GRID'):
+        return [('WEEKDAY_%d' % i, 'images/weekday_%d.pbi' % i) for i in range(10)]
+    if feature.startswith('WEEKDAY_'):
+        # The letters are shared by all languages
+        return [('WEEKDAY_LETTERS', 'images/weekday_letters.pbi')]
+    return []
+
+
+def write_features(profile):
+    lines = [
+        '/*',
+        ' * Big H',
+        ' * Feature profile, generated by tools/profile.py',
+        ' *',
+        ' * Profile: %s' % profile,
+        ' */',
+        '',
+        '#define FEATURE_PROFILE "%s"' % profile,
+        '',
+    ]
+    for feature in FEATURES:
+        lines.append('#define FEATURE_%s %d' % (feature, feature in PROFILES[profile]))
+    with open(os.path.join(ROOT, 'src', 'feature_profile.h'), 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+def profile_languages(profile):
+    # Profiles without weekday names keep the atlas of all languages, nothing of it is packaged
+    codes = [code for code, pitch, names in weekday_letters.LANGUAGES if 'WEEKDAY_' + code in PROFILES[profile]]
+    return codes or [code for code, pitch, names in weekday_letters.LANGUAGES]
+
+
+def write_weekday_letters(profile):
+    if weekday_letters.build(profile_languages(profile)):
+        raise ValueError('weekday letters: composed names differ from the images')
+    png_path = os.path.join(weekday_letters.IMAGES, 'weekday_letters.png')
+    write_pbi(png_path[:-len('.png')] + '.pbi', *read_png(png_path))
+
+
+def write_media(profile):
+    media = [('IMAGE_MENU_ICON', 'images/menu_icon_big_h.png', True)]
+    for feature in [None] + PROFILES[profile]:
+        media += [(name, path, False) for name, path in resources(feature) if name not in [entry[0] for entry in media]]
+    entries = []
+    for name, path, menu_icon in media:
+        entry = '      {\n'
+        if menu_icon:
+            entry += '        "menuIcon": true,\n'
+        # Glyphs are pre-converted to the native bitmap format by tools/pbi.py, the SDK's "pbi" type
+        # would convert them again from a PNG, "raw" packages them as is for gbitmap_create_with_resource
+        entry += '        "type": "%s",\n' % ('raw' if path.endswith('.pbi') else 'png')
+        entry += '        "name": "%s",\n' % name
+        entry += '        "file": "%s"\n' % path
+        entry += '      }'
+        entries.append(entry)
+
+    appinfo_path = os.path.join(ROOT, 'appinfo.json')
+    with open(appinfo_path) as f:
+        appinfo = f.read()
+    appinfo = re.sub(r'("media": \[\n).*?(\n    \])', lambda m: m.group(1) + ',\n'.join(entries) + m.group(2), appinfo, flags=re.S)
+    with open(appinfo_path, 'w') as f:
+        f.write(appinfo)
+    return [path for name, path, menu_icon in media]
+
+
+def write_capabilities(profile):
+    features = [None] + PROFILES[profile]
+    capabilities = ', '.join('"%s"' % name for name, feature in CAPABILITIES if feature in features)
+    app_keys = ',\n'.join('    "%s": %d' % (name, key) for name, key, feature in APP_KEYS if feature in features)
+
+    appinfo_path = os.path.join(ROOT, 'appinfo.json')
+    with open(appinfo_path) as f:
+        appinfo = f.read()
+    appinfo = re.sub(r'("capabilities": \[ ).*?( \])', lambda m: m.group(1) + capabilities + m.group(2), appinfo)
+    appinfo = re.sub(r'("appKeys": \{\n).*?(\n  \})', lambda m: m.group(1) + app_keys + m.group(2), appinfo, flags=re.S)
+    with open(appinfo_path, 'w') as f:
+        f.write(appinfo)
+
+
+def report(media):
+    resource_size = sum(os.path.getsize(os.path.join(ROOT, 'resources', path)) for path in media)
+    print('Resources: %d files, %d bytes' % (len(media), resource_size))
+    for path in glob.glob(os.path.join(ROOT, 'build', '*.pbpack')) + glob.glob(os.path.join(ROOT, 'build', '*', '*.pbpack')):
+        print('Resource pack: %s, %d bytes' % (os.path.relpath(path, ROOT), os.path.getsize(path)))
+    for path in glob.glob(os.path.join(ROOT, 'build', 'pebble-app.bin')) + glob.glob(os.path.join(ROOT, 'build', '*', 'pebble-app.bin')):
+        print('Binary: %s, %d bytes' % (os.path.relpath(path, ROOT), os.path.getsize(path)))
+    print('Heap: reported by the watchface at startup ("pebble logs")')
+
+
+def main(args):
+    build = '--build' in args
+    args = [arg for arg in args if arg != '--build']
+    if len(args) != 1 or args[0] not in PROFILES:
+        print('Usage: %s [--build] <%s>' % (sys.argv[0], '|'.join(sorted(PROFILES))), file=sys.stderr)
+        return 1
+
+    profile = args[0]
+    write_features(profile)
+    write_weekday_letters(profile)
+    media = write_media(profile)
+    write_capabilities(profile)
+    print('Profile: %s (%s)' % (profile, ', '.join(PROFILES[profile])))
+    if build:
+        subprocess.check_call(['pebble', 'build'], cwd=ROOT)
+    report(media)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,110 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ *
+ * Host stand-in for the Pebble SDK functions, see pebble.h.  Every function
+ * is weak so a test can replace it with its own.
+ */
+
+#include <stdlib.h>
+#include "pebble.h"
+
+#define STUB __attribute__((weak))
+
+
+// ===== Graphics =====
+STUB GBitmap *gbitmap_create_with_resource(uint32_t resource_id) { return NULL; }
+STUB GBitmap *gbitmap_create_as_sub_bitmap(const GBitmap *base, GRect sub_rect) { return NULL; }
+STUB void gbitmap_destroy(GBitmap *bitmap) {}
+
+STUB Layer *layer_create(GRect frame) {
+    Layer *layer = calloc(1, sizeof(Layer));
+    layer->frame = frame;
+    return layer;
+}
+STUB void layer_destroy(Layer *layer) { free(layer); }
+STUB void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {}
+STUB void layer_add_child(Layer *parent, Layer *child) {}
+STUB void layer_mark_dirty(Layer *layer) { layer->dirty++; }
+STUB void layer_set_hidden(Layer *layer, bool hidden) { layer->hidden = hidden; }
+STUB GRect layer_get_bounds(const Layer *layer) { return GRect(0, 0, layer->frame.size.w, layer->frame.size.h); }
+
+STUB void graphics_context_set_stroke_color(GContext *ctx, GColor color) {}
+STUB void graphics_context_set_fill_color(GContext *ctx, GColor color) {}
+STUB void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode) {}
+STUB void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {}
+STUB void graphics_draw_rect(GContext *ctx, GRect rect) {}
+STUB void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {}
+STUB void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius) {}
+STUB void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect) {}
+
+STUB Window *window_create(void) {
+    Window *window = calloc(1, sizeof(Window));
+    window->root.frame = GRect(0, 0, 144, 168);
+    return window;
+}
+STUB void window_destroy(Window *window) { free(window); }
+STUB void window_stack_push(Window *window, bool animated) {}
+STUB void window_set_background_color(Window *window, GColor background_color) {}
+STUB Layer *window_get_root_layer(const Window *window) { return (Layer *)&window->root; }
+
+
+// ===== Services =====
+STUB void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler) {}
+STUB void tick_timer_service_unsubscribe(void) {}
+STUB bool clock_is_24h_style(void) { return true; }
+
+STUB BatteryChargeState battery_state_service_peek(void) { return (BatteryChargeState){ .charge_percent = 100 }; }
+STUB void battery_state_service_subscribe(BatteryStateHandler handler) {}
+STUB void battery_state_service_unsubscribe(void) {}
+
+STUB void accel_tap_service_subscribe(AccelTapHandler handler) {}
+STUB void accel_tap_service_unsubscribe(void) {}
+
+STUB HealthValue health_service_sum_today(HealthMetric metric) { return 0; }
+STUB bool health_service_events_subscribe(HealthEventHandler handler, void *context) { return true; }
+STUB bool health_service_events_unsubscribe(void) { return true; }
+
+STUB void vibes_short_pulse(void) {}
+
+// Timers never fire on their own, a test can call the callbacks itself
+STUB AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data) { return (AppTimer *)callback; }
+STUB bool app_timer_reschedule(AppTimer *timer, uint32_t new_timeout_ms) { return true; }
+STUB void app_timer_cancel(AppTimer *timer) {}
+
+
+// ===== Storage =====
+STUB bool persist_exists(uint32_t key) { return false; }
+STUB int32_t persist_read_int(uint32_t key) { return 0; }
+STUB bool persist_read_bool(uint32_t key) { return false; }
+STUB int persist_read_string(uint32_t key, char *buffer, size_t buffer_size) { return 0; }
+STUB int persist_read_data(uint32_t key, void *buffer, size_t buffer_size) { return 0; }
+STUB int persist_write_int(uint32_t key, int32_t value) { return sizeof(value); }
+STUB int persist_write_bool(uint32_t key, bool value) { return sizeof(value); }
+STUB int persist_write_string(uint32_t key, const char *cstring) { return strlen(cstring) + 1; }
+STUB int persist_write_data(uint32_t key, const void *data, size_t size) { return size; }
+STUB int persist_delete(uint32_t key) { return 0; }
+
+
+// ===== Messages =====
+STUB Tuple *dict_read_first(DictionaryIterator *iter) { return NULL; }
+STUB Tuple *dict_read_next(DictionaryIterator *iter) { return NULL; }
+STUB void app_message_register_inbox_received(AppMessageInboxReceived received_callback) {}
+STUB void app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback) {}
+STUB void app_message_register_outbox_sent(AppMessageOutboxSent sent_callback) {}
+STUB void app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback) {}
+STUB uint32_t app_message_inbox_size_maximum(void) { return 0; }
+STUB uint32_t app_message_outbox_size_maximum(void) { return 0; }
+STUB AppMessageResult app_message_open(const uint32_t size_inbound, const uint32_t size_outbound) { return 0; }
+
+
+// ===== App =====
+STUB void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...) {}
+STUB void app_event_loop(void) {}
+STUB size_t heap_bytes_used(void) { return 0; }
+STUB size_t heap_bytes_free(void) { return 0; }
@@ -0,0 +1,180 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ *
+ * Host stand-in for the parts of the Pebble SDK 3 API used by the watchface,
+ * so the host tests in tools/ can compile src/big-h.c.  The functions do
+ * nothing (see pebble.c), tests override the ones they need to observe.
+ * Layers keep a count of layer_mark_dirty calls.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+
+// ===== Graphics =====
+typedef struct { int16_t x, y; } GPoint;
+typedef struct { int16_t w, h; } GSize;
+typedef struct { GPoint origin; GSize size; } GRect;
+#define GPoint(x, y) ((GPoint){(x), (y)})
+#define GSize(w, h) ((GSize){(w), (h)})
+#define GRect(x, y, w, h) ((GRect){{(x), (y)}, {(w), (h)}})
+
+typedef enum { GColorBlack, GColorWhite } GColor;
+typedef enum { GCornerNone } GCornerMask;
+typedef enum { GCompOpAssign, GCompOpAssignInverted, GCompOpOr, GCompOpAnd, GCompOpClear, GCompOpSet } GCompOp;
+
+typedef struct GContext GContext;
+typedef struct GBitmap GBitmap;
+typedef struct Layer {
+    GRect frame;
+    bool hidden;
+    uint32_t dirty;
+} Layer;
+typedef struct Window {
+    Layer root;
+} Window;
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+
+GBitmap *gbitmap_create_with_resource(uint32_t resource_id);
+GBitmap *gbitmap_create_as_sub_bitmap(const GBitmap *base, GRect sub_rect);
+void gbitmap_destroy(GBitmap *bitmap);
+
+Layer *layer_create(GRect frame);
+void layer_destroy(Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_add_child(Layer *parent, Layer *child);
+void layer_mark_dirty(Layer *layer);
+void layer_set_hidden(Layer *layer, bool hidden);
+GRect layer_get_bounds(const Layer *layer);
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_draw_rect(GContext *ctx, GRect rect);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask);
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect);
+
+Window *window_create(void);
+void window_destroy(Window *window);
+void window_stack_push(Window *window, bool animated);
+void window_set_background_color(Window *window, GColor background_color);
+Layer *window_get_root_layer(const Window *window);
+
+
+// ===== Services =====
+typedef enum { SECOND_UNIT = 1 << 0, MINUTE_UNIT = 1 << 1, HOUR_UNIT = 1 << 2, DAY_UNIT = 1 << 3, MONTH_UNIT = 1 << 4, YEAR_UNIT = 1 << 5 } TimeUnits;
+typedef void (*TickHandler)(struct tm *tick_time, TimeUnits units_changed);
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler);
+void tick_timer_service_unsubscribe(void);
+bool clock_is_24h_style(void);
+
+typedef struct { uint8_t charge_percent; bool is_charging; bool is_plugged; } BatteryChargeState;
+typedef void (*BatteryStateHandler)(BatteryChargeState charge);
+BatteryChargeState battery_state_service_peek(void);
+void battery_state_service_subscribe(BatteryStateHandler handler);
+void battery_state_service_unsubscribe(void);
+
+typedef enum { ACCEL_AXIS_X, ACCEL_AXIS_Y, ACCEL_AXIS_Z } AccelAxisType;
+typedef void (*AccelTapHandler)(AccelAxisType axis, int32_t direction);
+void accel_tap_service_subscribe(AccelTapHandler handler);
+void accel_tap_service_unsubscribe(void);
+
+typedef enum { HealthMetricStepCount, HealthMetricActiveSeconds, HealthMetricWalkedDistanceMeters, HealthMetricSleepSeconds } HealthMetric;
+typedef enum { HealthEventSignificantUpdate, HealthEventMovementUpdate, HealthEventSleepUpdate } HealthEventType;
+typedef int32_t HealthValue;
+typedef void (*HealthEventHandler)(HealthEventType event, void *context);
+HealthValue health_service_sum_today(HealthMetric metric);
+bool health_service_events_subscribe(HealthEventHandler handler, void *context);
+bool health_service_events_unsubscribe(void);
+
+void vibes_short_pulse(void);
+
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data);
+bool app_timer_reschedule(AppTimer *timer, uint32_t new_timeout_ms);
+void app_timer_cancel(AppTimer *timer);
+
+
+// ===== Storage =====
+bool persist_exists(uint32_t key);
+int32_t persist_read_int(uint32_t key);
+bool persist_read_bool(uint32_t key);
+int persist_read_string(uint32_t key, char *buffer, size_t buffer_size);
+int persist_read_data(uint32_t key, void *buffer, size_t buffer_size);
+int persist_write_int(uint32_t key, int32_t value);
+int persist_write_bool(uint32_t key, bool value);
+int persist_write_string(uint32_t key, const char *cstring);
+int persist_write_data(uint32_t key, const void *data, size_t size);
+int persist_delete(uint32_t key);
+
+
+// ===== Messages =====
+typedef enum { TUPLE_BYTE_ARRAY = 0, TUPLE_CSTRING = 1, TUPLE_UINT = 2, TUPLE_INT = 3 } TupleType;
+typedef struct __attribute__((__packed__)) {
+    uint32_t key;
+    TupleType type:8;
+    uint16_t length;
+    union {
+        uint8_t data[0];
+        char cstring[0];
+        uint8_t uint8;
+        uint16_t uint16;
+        uint32_t uint32;
+        int8_t int8;
+        int16_t int16;
+        int32_t int32;
+    } value[];
+} Tuple;
+typedef struct DictionaryIterator DictionaryIterator;
+typedef int AppMessageResult;
+Tuple *dict_read_first(DictionaryIterator *iter);
+Tuple *dict_read_next(DictionaryIterator *iter);
+
+typedef void (*AppMessageInboxReceived)(DictionaryIterator *iterator, void *context);
+typedef void (*AppMessageInboxDropped)(AppMessageResult reason, void *context);
+typedef void (*AppMessageOutboxSent)(DictionaryIterator *iterator, void *context);
+typedef void (*AppMessageOutboxFailed)(DictionaryIterator *iterator, AppMessageResult reason, void *context);
+void app_message_register_inbox_received(AppMessageInboxReceived received_callback);
+void app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback);
+void app_message_register_outbox_sent(AppMessageOutboxSent sent_callback);
+void app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback);
+uint32_t app_message_inbox_size_maximum(void);
+uint32_t app_message_outbox_size_maximum(void);
+AppMessageResult app_message_open(const uint32_t size_inbound, const uint32_t size_outbound);
+
+
+// ===== App =====
+enum { APP_LOG_LEVEL_ERROR = 1, APP_LOG_LEVEL_WARNING = 50, APP_LOG_LEVEL_INFO = 100, APP_LOG_LEVEL_DEBUG = 200 };
+#define APP_LOG(level, fmt, ...) app_log(level, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...);
+void app_event_loop(void);
+size_t heap_bytes_used(void);
+size_t heap_bytes_free(void);
+
+
+// ===== Resources =====
+enum {
+    RESOURCE_ID_IMAGE_MENU_ICON = 1,
+    RESOURCE_ID_DATE_0, RESOURCE_ID_DATE_1, RESOURCE_ID_DATE_2, RESOURCE_ID_DATE_3, RESOURCE_ID_DATE_4,
+    RESOURCE_ID_DATE_5, RESOURCE_ID_DATE_6, RESOURCE_ID_DATE_7, RESOURCE_ID_DATE_8, RESOURCE_ID_DATE_9,
+    RESOURCE_ID_TIME_0, RESOURCE_ID_TIME_1, RESOURCE_ID_TIME_2, RESOURCE_ID_TIME_3, RESOURCE_ID_TIME_4,
+    RESOURCE_ID_TIME_5, RESOURCE_ID_TIME_6, RESOURCE_ID_TIME_7, RESOURCE_ID_TIME_8, RESOURCE_ID_TIME_9,
+    RESOURCE_ID_WEEKDAY_0, RESOURCE_ID_WEEKDAY_1, RESOURCE_ID_WEEKDAY_2, RESOURCE_ID_WEEKDAY_3, RESOURCE_ID_WEEKDAY_4,
+    RESOURCE_ID_WEEKDAY_5, RESOURCE_ID_WEEKDAY_6, RESOURCE_ID_WEEKDAY_7, RESOURCE_ID_WEEKDAY_8, RESOURCE_ID_WEEKDAY_9,
+    RESOURCE_ID_WEEKDAY_LETTERS
+};
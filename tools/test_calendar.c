@@ -0,0 +1,117 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ *
+ * Host test of src/calendar.c: checks the weekday column and the month grid
+ * against the C library's calendar for every day of a full 400-year Gregorian
+ * cycle, with each day of the week in the top slot.
+ *
+ * Usage: make -C tools test
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "calendar.h"
+
+
+static const time_t Day_Seconds = 86400;
+// 2000-01-01 00:00:00 UTC, the 400-year cycle starts with a leap year divisible by 400
+static const time_t Cycle_Start = 946684800;
+static const long Cycle_Days = 146097;
+
+static long errors = 0;
+
+
+// Report a mismatch, only the first ones are printed
+static void fail(const struct tm *date, int16_t first_day, const char *what) {
+    if (errors++ < 10) {
+        printf("%04d-%02d-%02d, first day %d: %s\n", date->tm_year + 1900, date->tm_mon + 1, date->tm_mday, first_day, what);
+    }
+}
+
+
+// The date delta_days away from time, in UTC
+static struct tm date_at(time_t time, long delta_days) {
+    time_t other = time + delta_days * Day_Seconds;
+    struct tm date;
+    gmtime_r(&other, &date);
+    return date;
+}
+
+
+// Check the weekday column: every slot shows its own day of the week, at most 3 days away
+static void check_week(const Calendar_Type *calendar, time_t time, const struct tm *date, int16_t first_day) {
+    for (int16_t position = 0; position < Weekday_Nb; position++) {
+        int16_t delta = calendar->week_deltas[position];
+        struct tm shown = date_at(time, delta);
+        if (abs(delta) > Weekday_Max_Delta) {
+            fail(date, first_day, "week delta too large");
+        }
+        if ((shown.tm_wday - first_day + Weekday_Nb) % Weekday_Nb != position) {
+            fail(date, first_day, "week day in the wrong slot");
+        }
+        if (shown.tm_mday != calendar->week_mdays[position]) {
+            fail(date, first_day, "wrong week day of the month");
+        }
+    }
+}
+
+
+// Check the month grid: every day of the month once, in its day of the week's column, today in the right cell
+static void check_month(const Calendar_Type *calendar, time_t time, const struct tm *date, int16_t first_day) {
+    struct tm next_month_first = date_at(time, days_in_month(date->tm_year + 1900, date->tm_mon) - date->tm_mday + 1);
+    if (next_month_first.tm_mday != 1) {
+        fail(date, first_day, "wrong number of days in the month");
+    }
+
+    int16_t days_nb = 0;
+    for (int16_t cell = 0; cell < 42; cell++) {
+        int16_t mday = calendar->month_mdays[cell];
+        if (mday == 0) {
+            continue;
+        }
+        struct tm shown = date_at(time, mday - date->tm_mday);
+        if (shown.tm_mon != date->tm_mon || mday != ++days_nb) {
+            fail(date, first_day, "month grid days out of order");
+        }
+        if ((shown.tm_wday - first_day + Weekday_Nb) % Weekday_Nb != cell % Weekday_Nb) {
+            fail(date, first_day, "month grid day in the wrong column");
+        }
+        if (cell / Weekday_Nb >= calendar->month_rows) {
+            fail(date, first_day, "month grid day past the last row");
+        }
+    }
+    if (days_nb != days_in_month(date->tm_year + 1900, date->tm_mon)) {
+        fail(date, first_day, "month grid missing days");
+    }
+    if (calendar->month_rows < 4 || calendar->month_rows > 6 || calendar->month_mdays[(calendar->month_rows - 1) * Weekday_Nb] == 0) {
+        fail(date, first_day, "month grid with an empty row");
+    }
+    if (calendar->month_mdays[calendar->month_today] != date->tm_mday) {
+        fail(date, first_day, "wrong cell for today");
+    }
+}
+
+
+int main(void) {
+    Calendar_Type calendar;
+    long days = 0;
+    for (int16_t first_day = 0; first_day < Weekday_Nb; first_day++) {
+        for (long day = 0; day < Cycle_Days; day++) {
+            time_t time = Cycle_Start + day * Day_Seconds;
+            struct tm date = date_at(time, 0);
+            calendar_update(&calendar, &date, first_day);
+            check_week(&calendar, time, &date, first_day);
+            check_month(&calendar, time, &date, first_day);
+            days++;
+        }
+    }
+    printf("calendar: %ld days checked, %ld errors\n", days, errors);
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,167 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ *
+ * Host test of the second time zone: a stand-in for the phone side
+ * (secondTzTable in src/js/pebble-js-app.js) builds the transition table
+ * from the host's time zone database, the watch side decodes it and applies
+ * it to every minute of a year.  Checks the hour and minutes against the
+ * host's local time in that zone, across its DST changes, and that the date
+ * is only redrawn when one of the second time zone fields it shows changed.
+ *
+ * Usage: make -C tools test
+ */
+
+#define main big_h_main
+#include "big-h.c"
+#undef main
+
+#include <stdlib.h>
+
+
+// 2026-01-01 00:00:00 UTC
+static const time_t Replay_Start = 1767225600;
+static const int32_t Replay_Minutes = 365 * 24 * 60;
+// Same search as the phone: a day at a time, then down to the minute
+static const int16_t Scan_Days = 366;
+
+static long errors = 0;
+
+
+// UTC offset in minutes of zone at time
+static int16_t zone_offset(const char *zone, time_t time) {
+    struct tm local;
+    setenv("TZ", zone, 1);
+    tzset();
+    localtime_r(&time, &local);
+    return local.tm_gmtoff / 60;
+}
+
+
+// Append a transition in the table format: UTC time in seconds (4 bytes) and offset in minutes (2 bytes), little-endian
+static int16_t table_append(uint8_t *bytes, int16_t length, time_t time, int16_t offset) {
+    uint32_t seconds = time;
+    bytes[length++] = seconds & 0xFF;
+    bytes[length++] = (seconds >> 8) & 0xFF;
+    bytes[length++] = (seconds >> 16) & 0xFF;
+    bytes[length++] = (seconds >> 24) & 0xFF;
+    bytes[length++] = offset & 0xFF;
+    bytes[length++] = (offset >> 8) & 0xFF;
+    return length;
+}
+
+
+// Stand-in for secondTzTable: the offset at start, then each change over the next year, at most 32 entries
+static int16_t second_tz_table(const char *zone, time_t start, uint8_t *bytes) {
+    time_t time = start;
+    int16_t offset = zone_offset(zone, time),
+            length = table_append(bytes, 0, time, offset);
+    for (int16_t day = 1; day <= Scan_Days && length < SECOND_TZ_TRANSITIONS_MAX * SECOND_TZ_TRANSITION_SIZE; day++) {
+        time_t next = time + 86400;
+        int16_t next_offset = zone_offset(zone, next);
+        if (next_offset != offset) {
+            time_t low = time,
+                   high = next;
+            while (high - low > 60) {
+                time_t middle = low + (high - low) / 120 * 60;
+                if (zone_offset(zone, middle) == offset) {
+                    low = middle;
+                }
+                else {
+                    high = middle;
+                }
+            }
+            length = table_append(bytes, length, high, next_offset);
+        }
+        time = next;
+        offset = next_offset;
+    }
+    return length;
+}
+
+
+// What the second time zone fields of format show at time, in zone
+static void shown_fields(const char *format, const char *zone, time_t time, char *shown) {
+    struct tm local;
+    setenv("TZ", zone, 1);
+    tzset();
+    localtime_r(&time, &local);
+    shown[0] = '\0';
+    for (const char *c = format; *c; c++) {
+        char field[4] = "";
+        switch (*c) {
+            case 'H':
+                snprintf(field, sizeof(field), "%02d", local.tm_hour);
+                break;
+            case 'h':
+                snprintf(field, sizeof(field), "%02d", local.tm_hour % 12 == 0 ? 12 : local.tm_hour % 12);
+                break;
+            case 'N':
+                snprintf(field, sizeof(field), "%02d", local.tm_min);
+                break;
+        }
+        strcat(shown, field);
+    }
+}
+
+
+// Replay a year of minutes in zone with the date column showing format
+static void replay(const char *zone, const char *format) {
+    uint8_t bytes[SECOND_TZ_TRANSITIONS_MAX * SECOND_TZ_TRANSITION_SIZE];
+    int16_t length = second_tz_table(zone, Replay_Start, bytes);
+
+    snprintf(settings.date_format, sizeof(settings.date_format), "%s", format);
+    second_tz_load(bytes, length);
+    second_tz_hour = second_tz_minute = -1;
+    second_tz_update(Replay_Start - 60);
+    date_layer->dirty = 0;
+
+    char previous[16], shown[16];
+    shown_fields(format, zone, Replay_Start - 60, previous);
+    uint32_t changes = 0,
+             mismatches = 0;
+    for (int32_t minute = 0; minute < Replay_Minutes; minute++) {
+        time_t time = Replay_Start + minute * 60;
+        struct tm local;
+        setenv("TZ", zone, 1);
+        tzset();
+        localtime_r(&time, &local);
+
+        second_tz_update(time);
+        if (second_tz_hour != local.tm_hour || second_tz_minute != local.tm_min) {
+            mismatches++;
+        }
+        shown_fields(format, zone, time, shown);
+        if (strcmp(shown, previous) != 0) {
+            changes++;
+            strcpy(previous, shown);
+        }
+    }
+    if (mismatches || date_layer->dirty != changes) {
+        errors++;
+    }
+    printf("second tz: %-20s %-6s %2d transitions, %lu wrong minutes, %lu redraws for %lu changes\n",
+           zone, format, length / SECOND_TZ_TRANSITION_SIZE, (unsigned long)mismatches, (unsigned long)date_layer->dirty, (unsigned long)changes);
+}
+
+
+int main(void) {
+    handle_init();
+
+    const char *zones[] = { "America/New_York", "Europe/Paris", "Australia/Lord_Howe", "Asia/Kolkata" };
+    const char *formats[] = { "hN", "H", "Y-M-D" };
+    for (size_t zone = 0; zone < sizeof(zones) / sizeof(zones[0]); zone++) {
+        for (size_t format = 0; format < sizeof(formats) / sizeof(formats[0]); format++) {
+            replay(zones[zone], formats[format]);
+        }
+    }
+    printf("second tz: %ld errors\n", errors);
+
+    handle_deinit();
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ *
+ * Host test of the step progress mode: replays a day of step samples through
+ * a stubbed health service (minute ticks, movement events while walking),
+ * checks that the rail always shows the current step count and reports the
+ * wakeups and redraws the mode adds.  Ticks run anyway, only the health
+ * events are added wakeups.
+ *
+ * Usage: make -C tools test
+ */
+
+#define main big_h_main
+#include "big-h.c"
+#undef main
+
+
+static HealthValue steps_today = 0;
+static uint32_t health_sums = 0;
+
+
+// Stubbed health service, returns the replayed count
+HealthValue health_service_sum_today(HealthMetric metric) {
+    health_sums++;
+    return metric == HealthMetricStepCount ? steps_today : 0;
+}
+
+
+// Stored settings: step progress with the default goal, no seconds and no battery
+bool persist_exists(uint32_t key) {
+    return true;
+}
+
+bool persist_read_bool(uint32_t key) {
+    return key == Key_Display_Steps;
+}
+
+int32_t persist_read_int(uint32_t key) {
+    return key == Key_Step_Goal ? Steps_Default_Goal : 0;
+}
+
+int persist_read_string(uint32_t key, char *buffer, size_t buffer_size) {
+    buffer[0] = '\0';
+    return 1;
+}
+
+
+// Steps walked during a minute of the day: nothing at night, short walks during the day, a longer one in the evening
+static int16_t minute_steps(int16_t minute, uint32_t *seed) {
+    *seed = *seed * 1103515245 + 12345;
+    int16_t hour = minute / 60,
+            random = (*seed >> 16) % 100;
+    if (hour < 7 || hour >= 23) {
+        return 0;
+    }
+    if (hour == 18) {
+        return 90 + random % 30;
+    }
+    return random < 25 ? 10 + random * 3 : 0;
+}
+
+
+int main(void) {
+    handle_init();
+
+    // Start just before midnight, the day's ticks then come one minute apart
+    struct tm tick = current_time;
+    tick.tm_hour = 23;
+    tick.tm_min = 59;
+    tick.tm_sec = 0;
+    current_time = tick;
+    tick.tm_mday++;
+    tick.tm_wday = (tick.tm_wday + 1) % 7;
+    tick.tm_hour = 0;
+    tick.tm_min = 0;
+
+    steps_events = steps_reads = steps_redraws = 0;
+    seconds_bg_layer->dirty = 0;
+    health_sums = 0;
+
+    uint32_t seed = 1,
+             ticks = 0,
+             changes = 0,
+             late = 0;
+    int32_t previous_steps = 0;
+    // New day, the step count goes back to 0
+    steps_today = 0;
+    handle_health(HealthEventSignificantUpdate, NULL);
+    for (int16_t minute = 0; minute < 24 * 60; minute++) {
+        tick.tm_hour = minute / 60;
+        tick.tm_min = minute % 60;
+        handle_tick(&tick, MINUTE_UNIT);
+        ticks++;
+
+        // Walking during the minute, the firmware sends a movement event along the way
+        int16_t walked = minute_steps(minute, &seed);
+        if (walked > 0) {
+            steps_today += walked;
+            handle_health(HealthEventMovementUpdate, NULL);
+        }
+
+        // The rail must show the current count
+        int32_t steps = steps_today < settings.step_goal ? steps_today : settings.step_goal;
+        if (steps_width != Seconds_BG_Layer_Dim.width * steps / settings.step_goal) {
+            late++;
+        }
+        if (steps != previous_steps) {
+            changes++;
+            previous_steps = steps;
+        }
+    }
+
+    printf("steps: %ld steps over %lu minute ticks\n", (long)steps_today, (unsigned long)ticks);
+    printf("steps: %lu added wakeups (health events), %lu health reads\n",
+           (unsigned long)steps_events, (unsigned long)health_sums);
+    printf("steps: %lu rail redraws, %lu without the width check (%lu step count changes)\n",
+           (unsigned long)seconds_bg_layer->dirty, (unsigned long)health_sums, (unsigned long)changes);
+    printf("steps: %lu minutes with a stale rail\n", (unsigned long)late);
+
+    handle_deinit();
+    return late ? 1 : 0;
+}
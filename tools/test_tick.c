@@ -0,0 +1,167 @@
+/*
+ * Big H
+ * Watchface for Pebble smartwatch
+ *
+ * https://github.com/samalander/big-h
+ *
+ * Licensed under the LGPLv3
+ * see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+ *
+ * Host test of handle_tick: replays seconds, missed ticks and clock jumps
+ * (DST, time zone changes, time set by hand) in 12-hour and 24-hour modes,
+ * and checks that each layer is marked dirty exactly when the value it shows
+ * changed: no stale layer, no extra redraw.  Also checks the hourly vibration,
+ * including every second around the DST changes.
+ *
+ * Usage: make -C tools test
+ */
+
+#define main big_h_main
+#include "big-h.c"
+#undef main
+
+#include <stdlib.h>
+
+
+// 2026-03-01 00:00:00 UTC, the replay crosses the spring and fall DST changes
+static const time_t Replay_Start = 1772323200;
+static const int32_t Replay_Ticks = 200000;
+// New York's DST changes in 2026: 02:00 EST becomes 03:00 EDT, 02:00 EDT becomes 01:00 EST
+static const time_t DST_Starts = 1772953200,
+                    DST_Ends = 1793512800;
+
+enum { Shown_Seconds, Shown_Minutes, Shown_Hours, Shown_AmPm, Shown_Month, Shown_Weekday, Shown_Date, Shown_Nb };
+static const char *Shown_Names[Shown_Nb] = { "seconds", "minutes", "hours", "ampm", "month", "weekday", "date" };
+
+static bool clock_24h = false;
+static uint32_t vibrations = 0;
+
+static Layer *layers[Shown_Nb];
+static uint32_t ticks = 0,
+                stale[Shown_Nb] = { 0 },
+                extra[Shown_Nb] = { 0 },
+                redraws[Shown_Nb] = { 0 },
+                wrong_vibrations = 0;
+
+
+// Stubbed clock settings and vibrations
+bool clock_is_24h_style(void) {
+    return clock_24h;
+}
+
+void vibes_short_pulse(void) {
+    vibrations++;
+}
+
+
+// What each layer shows at a given time
+static void shown_values(const struct tm *time, int32_t shown[Shown_Nb]) {
+    shown[Shown_Seconds] = time->tm_sec;
+    shown[Shown_Minutes] = time->tm_min;
+    shown[Shown_Hours] = display_hour(time->tm_hour);
+    shown[Shown_AmPm] = clock_24h ? 0 : time->tm_hour < 12;
+    shown[Shown_Month] = shown[Shown_Weekday] = shown[Shown_Date] = (time->tm_year * 12 + time->tm_mon) * 32 + time->tm_mday;
+}
+
+
+// Next step of the replay: mostly seconds, sometimes missed ticks, days or half days forward or back
+static time_t next_step(void) {
+    int16_t kind = rand() % 100;
+    if (kind < 80) {
+        return 1;
+    }
+    if (kind < 90) {
+        return 60 * (1 + rand() % 5);
+    }
+    if (kind < 95) {
+        return (rand() % 86400) * 3 - 86400;
+    }
+    return rand() % 2 ? 43200 : -43200;
+}
+
+
+// Tick at time, the watch showing the previous tick's time until then; returns the number of vibrations
+static uint32_t tick(time_t time) {
+    struct tm previous = current_time,
+              now = *localtime(&time);
+    int32_t shown_before[Shown_Nb], shown_after[Shown_Nb];
+    shown_values(&previous, shown_before);
+    shown_values(&now, shown_after);
+
+    for (int16_t layer = 0; layer < Shown_Nb; layer++) {
+        layers[layer]->dirty = 0;
+    }
+    uint32_t vibrations_before = vibrations;
+    handle_tick(&now, SECOND_UNIT);
+    ticks++;
+
+    for (int16_t layer = 0; layer < Shown_Nb; layer++) {
+        bool changed = shown_before[layer] != shown_after[layer];
+        redraws[layer] += layers[layer]->dirty;
+        if (changed && layers[layer]->dirty == 0) {
+            stale[layer]++;
+        }
+        if (layers[layer]->dirty > (changed ? 1 : 0)) {
+            extra[layer]++;
+        }
+    }
+    // One vibration each time the minutes display turns to 00, whatever the hours do
+    bool turns_to_00 = shown_after[Shown_Minutes] == 0 && shown_before[Shown_Minutes] != 0;
+    if (vibrations - vibrations_before != (turns_to_00 ? 1 : 0)) {
+        wrong_vibrations++;
+    }
+    return vibrations - vibrations_before;
+}
+
+
+// Tick every second of the hour before and after a DST change, returns the number of vibrations
+static uint32_t replay_dst_change(time_t change) {
+    time_t time = change - 3600;
+    current_time = *localtime(&time);
+    uint32_t total = 0;
+    while (time < change + 3600) {
+        total += tick(++time);
+    }
+    return total;
+}
+
+
+int main(void) {
+    setenv("TZ", "America/New_York", 1);
+    tzset();
+    handle_init();
+    settings.vibrate_on_hour = true;
+
+    Layer *watched[Shown_Nb] = { seconds_layer, minutes_layer, hours_layer, ampm_layer, month_layer, weekday_layer, date_layer };
+    memcpy(layers, watched, sizeof(layers));
+    uint32_t errors = 0;
+    for (int16_t mode = 0; mode < 2; mode++) {
+        clock_24h = mode == 1;
+        time_t time = Replay_Start;
+        current_time = *localtime(&time);
+        srand(1);
+        for (int32_t i = 0; i < Replay_Ticks; i++) {
+            time += next_step();
+            tick(time);
+        }
+
+        // 01:00:01 EST to 04:00 EDT: 03:00 EDT right after 01:59:59 EST, then 04:00 EDT
+        uint32_t spring = replay_dst_change(DST_Starts),
+        // 01:00:01 EDT to 02:00 EST: 01:00 EST right after 01:59:59 EDT, the hour doesn't change, then 02:00 EST
+                 fall = replay_dst_change(DST_Ends);
+        printf("tick: %s, DST start %lu vibrations, DST end %lu vibrations\n", clock_24h ? "24h" : "12h", (unsigned long)spring, (unsigned long)fall);
+        if (spring != 2 || fall != 2) {
+            errors++;
+        }
+    }
+
+    errors += wrong_vibrations;
+    printf("tick: %lu ticks, %lu wrong vibrations\n", (unsigned long)ticks, (unsigned long)wrong_vibrations);
+    for (int16_t layer = 0; layer < Shown_Nb; layer++) {
+        printf("tick: %-8s %7lu redraws, %lu stale, %lu extra\n", Shown_Names[layer], (unsigned long)redraws[layer], (unsigned long)stale[layer], (unsigned long)extra[layer]);
+        errors += stale[layer] + extra[layer];
+    }
+
+    handle_deinit();
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,276 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+#
+# Big H
+# Watchface for Pebble smartwatch
+#
+# https://github.com/samalander/big-h
+#
+# Licensed under the LGPLv3
+# see included LICENSE file or http://www.gnu.org/copyleft/lesser.html
+#
+# Builds the weekday letter atlas (resources/images/weekday_letters.png) and
+# the per-language tables (src/weekday_letters.h) from the weekday name
+# images, then checks that composing the names from the atlas gives images
+# identical to the original ones.  Only the letters of the given languages
+# go into the atlas (all languages by default), tools/profile.py uses this
+# for the single-language profiles.
+#
+# Adding a language: draw its weekday names as weekday_<lang>_<0-6>.png
+# (only new letters are added to the atlas), add it to LANGUAGES below and
+# to the weekday formats of the watchface, then run tools/weekday_letters.py
+# followed by tools/pbi.py.
+#
+# Usage: tools/weekday_letters.py [<language> ...]
+
+from __future__ import print_function
+
+import io
+import os
+import struct
+import sys
+import zlib
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from pbi import read_png
+
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), os.pardir)
+IMAGES = os.path.join(ROOT, 'resources', 'images')
+
+# (code, baseline pitch, weekday names from Sunday)
+LANGUAGES = [
+    ('EN', 18, [u'Sunday', u'Monday', u'Tuesday', u'Wednesday', u'Thursday', u'Friday', u'Saturday']),
+    ('FR', 21, [u'Dimanche', u'Lundi', u'Mardi', u'Mercredi', u'Jeudi', u'Vendredi', u'Samedi']),
+    ('ES', 18, [u'Domingo', u'Lunes', u'Martes', u'Miércoles', u'Jueves', u'Viernes', u'Sábado']),
+]
+
+# Rows between a dot or an accent and the rest of its letter
+MAX_ACCENT_HEIGHT = 2
+
+
+def letter_segments(rows):
+    """Splits a weekday name image into (top, bitmap rows) for each letter"""
+    segments = []
+    y = 0
+    while y < len(rows):
+        if any(rows[y]):
+            top = y
+            while y < len(rows) and any(rows[y]):
+                y += 1
+            segments.append((top, rows[top:y]))
+        else:
+            y += 1
+
+    # Dots and accents are part of the letter under them
+    letters = []
+    i = 0
+    while i < len(segments):
+        top, bitmap = segments[i]
+        if len(bitmap) <= MAX_ACCENT_HEIGHT and i + 1 < len(segments):
+            next_top, next_bitmap = segments[i + 1]
+            gap = [[0] * len(bitmap[0]) for _ in range(next_top - top - len(bitmap))]
+            bitmap = bitmap + gap + next_bitmap
+            i += 1
+        letters.append((top, bitmap))
+        i += 1
+    return letters
+
+
+def trim(bitmap):
+    """Returns (left, trimmed bitmap) keeping only the columns with pixels"""
+    columns = [x for x in range(len(bitmap[0])) if any(row[x] for row in bitmap)]
+    left, right = columns[0], columns[-1] + 1
+    return left, tuple(tuple(row[left:right]) for row in bitmap)
+
+
+def analyze(codes):
+    glyphs = []
+    languages = []
+    for code, pitch, names in LANGUAGES:
+        if code not in codes:
+            continue
+        letters = {}
+        days = []
+        for wday, name in enumerate(names):
+            width, height, rows = read_png(os.path.join(IMAGES, 'weekday_%s_%d.png' % (code.lower(), wday)))
+            segments = letter_segments(rows)
+            if len(segments) != len(name):
+                raise ValueError('weekday_%s_%d.png: found %d letters for "%s"' % (code.lower(), wday, len(segments), name))
+            placed = []
+            for i, (char, (top, bitmap)) in enumerate(zip(name, segments)):
+                left, shape = trim(bitmap)
+                if shape not in glyphs:
+                    glyphs.append(shape)
+                letter = letters.setdefault(char, {'glyph': glyphs.index(shape), 'x': set()})
+                if letter['glyph'] != glyphs.index(shape):
+                    raise ValueError('weekday_%s_%d.png: "%s" differs from its other occurrences' % (code.lower(), wday, char))
+                letter['x'].add(left)
+                placed.append((char, left, top - i * pitch))
+            days.append(placed)
+
+        # Letters are placed at their leftmost position, some occurrences are one pixel to the right
+        for char, letter in letters.items():
+            if max(letter['x']) - min(letter['x']) > 1:
+                raise ValueError('%s: "%s" found at too many horizontal positions' % (code, char))
+            letter['x'] = min(letter['x'])
+
+        # Vertical position of each letter relative to the baseline, each name having its own baseline
+        offsets = {names[0][0]: 0}
+        baselines = [None] * len(days)
+        while None in baselines:
+            progress = False
+            for wday, placed in enumerate(days):
+                known = [(char, top) for char, left, top in placed if char in offsets]
+                if baselines[wday] is None and known:
+                    baselines[wday] = known[0][1] - offsets[known[0][0]]
+                    progress = True
+                if baselines[wday] is not None:
+                    for char, left, top in placed:
+                        offset = top - baselines[wday]
+                        if offsets.setdefault(char, offset) != offset:
+                            raise ValueError('%s: "%s" found at inconsistent heights' % (code, char))
+            if not progress:
+                raise ValueError('%s: cannot relate the letters of every weekday' % code)
+
+        # Make the baseline the row under the most common letter bottom
+        bottoms = [offsets[char] + len(glyphs[letter['glyph']]) for char, letter in letters.items()]
+        bottom = max(set(bottoms), key=bottoms.count)
+        for char in offsets:
+            offsets[char] -= bottom
+        baselines = [baseline + bottom for baseline in baselines]
+
+        shifts = []
+        for placed in days:
+            shifts.append(sum(1 << i for i, (char, left, top) in enumerate(placed) if left != letters[char]['x']))
+
+        languages.append({
+            'code': code,
+            'pitch': pitch,
+            'names': names,
+            'letters': sorted((ord(char), letter['glyph'], letter['x'], offsets[char]) for char, letter in letters.items()),
+            'baselines': baselines,
+            'shifts': shifts,
+        })
+    return glyphs, languages
+
+
+def atlas_layout(glyphs):
+    x = 0
+    layout = []
+    for shape in glyphs:
+        layout.append((x, len(shape[0]), len(shape)))
+        x += len(shape[0])
+    return x, max(len(shape) for shape in glyphs), layout
+
+
+def write_png(path, width, height, pixels):
+    """Writes a 1-bit black and white PNG"""
+    raw = b''
+    for row in pixels:
+        line = bytearray((width + 7) // 8)
+        for x, pixel in enumerate(row):
+            line[x // 8] |= pixel << (7 - x % 8)
+        raw += b'\x00' + bytes(line)
+
+    def chunk(chunk_type, data):
+        return struct.pack('>I', len(data)) + chunk_type + data + struct.pack('>I', zlib.crc32(chunk_type + data) & 0xffffffff)
+
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 1, 3, 0, 0, 0)))
+        f.write(chunk(b'PLTE', b'\x00\x00\x00\xff\xff\xff'))
+        f.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def write_atlas(glyphs):
+    width, height, layout = atlas_layout(glyphs)
+    pixels = [[0] * width for _ in range(height)]
+    for shape, (x, w, h) in zip(glyphs, layout):
+        for y, row in enumerate(shape):
+            pixels[y][x:x + w] = row
+    write_png(os.path.join(IMAGES, 'weekday_letters.png'), width, height, pixels)
+
+
+def c_string(text):
+    # Octal escapes can't run into the following characters like hexadecimal ones
+    return '"' + ''.join(chr(byte) if byte < 0x80 else '\\%03o' % byte for byte in bytearray(text.encode('utf-8'))) + '"'
+
+
+def write_header(glyphs, languages):
+    width, height, layout = atlas_layout(glyphs)
+    out = io.StringIO()
+    out.write(u'/*\n * Big H\n * Weekday letters, generated by tools/weekday_letters.py\n */\n\n')
+    out.write(u'#define WEEKDAY_GLYPHS_NB %d\n\n' % len(glyphs))
+    out.write(u'// Position of each glyph in the RESOURCE_ID_WEEKDAY_LETTERS atlas\n')
+    out.write(u'static const Weekday_Glyph Weekday_Glyphs[WEEKDAY_GLYPHS_NB] = {\n')
+    out.write(u',\n'.join(u'    {%d, %d, %d}' % entry for entry in layout))
+    out.write(u'\n};\n')
+    for language in languages:
+        code = language['code']
+        out.write(u'\n#if FEATURE_WEEKDAY_%s\n' % code)
+        out.write(u'static const Weekday_Letter Weekday_Letters_%s[] = {\n' % code)
+        out.write(u',\n'.join(u'    {0x%04x, %d, %d, %d}' % letter for letter in language['letters']))
+        out.write(u'\n};\n\n')
+        out.write(u'static const Weekday_Language Weekday_Language_%s = {\n' % code)
+        out.write(u'    %d,\n' % language['pitch'])
+        out.write(u'    Weekday_Letters_%s,\n' % code)
+        out.write(u'    %d,\n' % len(language['letters']))
+        out.write(u'    {%s},\n' % u', '.join(c_string(name) for name in language['names']))
+        out.write(u'    {%s},\n' % u', '.join(u'%d' % baseline for baseline in language['baselines']))
+        out.write(u'    {%s}\n' % u', '.join(u'0x%02x' % shift for shift in language['shifts']))
+        out.write(u'};\n')
+        out.write(u'#endif\n')
+    with io.open(os.path.join(ROOT, 'src', 'weekday_letters.h'), 'w', newline='\n') as f:
+        f.write(out.getvalue())
+
+
+def compose(glyphs, language, wday):
+    """Composes a weekday name the same way the watchface does"""
+    width, height, layout = atlas_layout(glyphs)
+    letters = dict((letter[0], letter[1:]) for letter in language['letters'])
+    pixels = [[0] * 14 for _ in range(168)]
+    baseline = language['baselines'][wday]
+    for i, char in enumerate(language['names'][wday]):
+        glyph, x, y = letters[ord(char)]
+        x += (language['shifts'][wday] >> i) & 1
+        for row, line in enumerate(glyphs[glyph]):
+            pixels[baseline + y + row][x:x + len(line)] = line
+        baseline += language['pitch']
+    return pixels
+
+
+def check(glyphs, languages):
+    errors = 0
+    for language in languages:
+        for wday in range(7):
+            name = 'weekday_%s_%d.png' % (language['code'].lower(), wday)
+            if compose(glyphs, language, wday) != read_png(os.path.join(IMAGES, name))[2]:
+                print('%s: composed weekday differs from the image' % name)
+                errors += 1
+    return errors
+
+
+def build(codes):
+    glyphs, languages = analyze(codes)
+    write_atlas(glyphs)
+    write_header(glyphs, languages)
+    errors = check(glyphs, languages)
+    width, height, layout = atlas_layout(glyphs)
+    print('%d glyphs in a %dx%d atlas, %s, %d errors' % (len(glyphs), width, height, ' '.join(codes), errors))
+    return errors
+
+
+def main(args):
+    all_codes = [code for code, pitch, names in LANGUAGES]
+    codes = [arg.upper() for arg in args] or all_codes
+    if any(code not in all_codes for code in codes):
+        print('Usage: %s [%s ...]' % (sys.argv[0], '|'.join(all_codes)), file=sys.stderr)
+        return 1
+    # Keep the atlas order independent of the command line
+    return 1 if build([code for code in all_codes if code in codes]) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
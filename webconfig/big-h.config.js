@@ -9,6 +9,9 @@ $(document).ready(function() {
 		settings.weekday_first_day = 0 || $('div#weekday_first_day input[name="weekday_first_day"]:checked').val();
 		settings.date_format = $('#date_format_default:checked').length == 1 ? '' : $('div#date_format_custom_set option:selected').map(function() {return $(this).val()}).get().join('');
 		settings.display_battery = $('#display_battery_field:checked').length;
+		settings.display_steps = $('#display_steps_field:checked').length;
+		settings.step_goal = Math.min(Math.max(parseInt($('#step_goal_field').val(), 10) || 10000, 1), 100000);
+		settings.second_tz = $.trim($('#second_tz_field').val());
 		window.location.href = "pebblejs://close#" + encodeURIComponent(JSON.stringify(settings));
 	});
 	$('#cancel').click(function() {